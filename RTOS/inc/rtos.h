@@ -14,15 +14,28 @@
 #include "rtos_config.h"
 #include "rtos_list.h"
 #include "rtos_thread.h"
+#include "rtos_trace.h"
+#include "rtos_log.h"
+#include "rtos_hooks.h"
+#include "rtos_stats.h"
 #include "rtos_mutex.h"
 #include "rtos_semaphore.h"
 #include "rtos_mailbox.h"
+#include "rtos_rwlock.h"
+#include "rtos_condvar.h"
+#include "rtos_seqlock.h"
+#include "rtos_ringbuffer.h"
+#include "rtos_streambuffer.h"
+#include "rtos_queueset.h"
+#include "rtos_ipc.h"
+#include "rtos_msgqueue.h"
 
 typedef enum
 {
   RTOS_SUCCESS,
   RTOS_FAILURE,
-  RTOS_CONTEXT_SWITCH_TRIGGERED
+  RTOS_CONTEXT_SWITCH_TRIGGERED,
+  RTOS_MUTEX_OWNER_DIED
 } RTOS_return_t;
 
 
@@ -38,5 +51,9 @@ void RTOS_SVC_Handler_main(uint32_t * svc_args);
 void RTOS_SysTick_Handler(void);
 void RTOS_SVC_schedulerStart(void);
 uint32_t RTOS_isSchedulerRunning(void);
+void RTOS_getThreadStats(RTOS_thread_t * pThread, RTOS_threadStatsReport_t * pReport);
+void RTOS_SVC_getThreadStats(RTOS_thread_t * pThread, RTOS_threadStatsReport_t * pReport);
+uint32_t RTOS_getCycleCounter(void);
+uint32_t RTOS_SVC_getCycleCounter(void);
 
 #endif /* INC_RTOS_H_ */
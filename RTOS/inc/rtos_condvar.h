@@ -0,0 +1,36 @@
+/*
+ * rtos_condvar.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_CONDVAR_H_
+#define INC_RTOS_CONDVAR_H_
+
+/**
+ * @brief Condition variable wait state of a thread
+ */
+#define CONDVAR_NOT_WAITING			((uint32_t) 0u)
+#define CONDVAR_WAITING				((uint32_t) 1u)
+#define CONDVAR_SIGNALED			((uint32_t) 2u)
+#define CONDVAR_TIMED_OUT			((uint32_t) 3u)
+
+typedef struct
+{
+	RTOS_list_t waitingList;
+} RTOS_condvar_t;
+
+void RTOS_condvarCreate(RTOS_condvar_t * pCondvar);
+void RTOS_SVC_condvarCreate(RTOS_condvar_t * pCondvar);
+
+uint32_t RTOS_condvarWait(RTOS_condvar_t * pCondvar, int32_t waitTime, RTOS_mutex_t * pMutex);
+uint32_t RTOS_SVC_condvarWait(RTOS_condvar_t * pCondvar, int32_t waitTime, RTOS_mutex_t * pMutex);
+
+void RTOS_condvarSignal(RTOS_condvar_t * pCondvar);
+void RTOS_SVC_condvarSignal(RTOS_condvar_t * pCondvar);
+
+void RTOS_condvarBroadcast(RTOS_condvar_t * pCondvar);
+void RTOS_SVC_condvarBroadcast(RTOS_condvar_t * pCondvar);
+
+#endif /* INC_RTOS_CONDVAR_H_ */
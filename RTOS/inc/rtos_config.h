@@ -19,6 +19,80 @@
  */
 #define THREAD_PRIORITY_LEVELS		((uint32_t) 16u)
 
+/**
+ * @brief Default round-robin time slice of each priority level in ticks,
+ * 0 disables round-robin between threads of equal priority
+ */
+#define THREAD_TIME_SLICE_TICKS		((uint32_t) 1u)
+
+/**
+ * @brief Earliest deadline first scheduling class
+ * 1 to schedule the threads of EDF_PRIORITY_LEVEL by absolute deadline,
+ * 0 to keep round-robin at every priority level
+ */
+#define EDF_ENABLE					0
+
+/**
+ * @brief Priority level of the EDF threads, fixed priority threads above
+ * and below this level are scheduled as usual
+ */
+#define EDF_PRIORITY_LEVEL			((uint32_t) 8u)
+
+/**
+ * @brief Maximum number of semaphores, mailboxes and stream buffers in a queue set
+ */
+#define QUEUE_SET_MAX_MEMBERS		((uint32_t) 8u)
+
+/**
+ * @brief Number of message priorities of a priority message queue, at most 32
+ */
+#define MSG_QUEUE_PRIORITY_LEVELS	((uint32_t) 8u)
+
+/**
+ * @brief Thread run time accounting
+ * 1 to measure the run time, blocked time and context switches of each thread
+ * with the DWT cycle counter, 0 to compile the accounting out
+ */
+#define THREAD_STATS_ENABLE			1
+
+/**
+ * @brief Kernel statistics counters
+ * 1 to count SVC calls, context switches, list high water marks and the longest
+ * critical section, 0 to compile the counters out
+ */
+#define KERNEL_STATS_ENABLE			1
+
+/**
+ * @brief Kernel trace recorder
+ * 1 to record kernel events with DWT cycle counter timestamps into RTOS_traceBuffer,
+ * 0 to compile the recording out
+ */
+#define TRACE_ENABLE				0
+
+/**
+ * @brief Number of events kept in the trace buffer, must be a power of two
+ */
+#define TRACE_BUFFER_EVENTS			((uint32_t) 1024u)
+
+/**
+ * @brief Deferred logging
+ * 1 to store RTOS_LOG format string addresses and raw arguments into RTOS_logBuffer,
+ * 0 to compile the logging out
+ */
+#define LOG_ENABLE					1
+
+/**
+ * @brief Number of records kept in the log buffer, must be a power of two
+ */
+#define LOG_BUFFER_RECORDS			((uint32_t) 64u)
+
+/**
+ * @brief Log buffer without a consumer thread
+ * 1 to overwrite the oldest record when the ring is full, the log is only read from a RAM dump,
+ * 0 to drop the newest record until RTOS_logGet frees a slot
+ */
+#define LOG_OVERWRITE				0
+
 /**
  * @brief CPU clock frequency in hertz
  */
@@ -0,0 +1,123 @@
+/*
+ * rtos_hooks.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_HOOKS_H_
+#define INC_RTOS_HOOKS_H_
+
+/*
+ * Kernel event hooks.
+ *
+ * Each hook is a macro defaulting to an empty static inline function, so unused
+ * hooks generate no code. The trace recorder is called separately at the call
+ * sites, so overriding a hook keeps the trace events. To attach a profiler, logger
+ * or watchdog, define the hook macros in a header and pass its name at compile
+ * time, e.g. -DRTOS_HOOKS_HEADER=\"my_hooks.h\". Hooks run in handler mode with
+ * the kernel lists being updated, they must be short and must not call the kernel.
+ */
+#if defined(RTOS_HOOKS_HEADER)
+#include RTOS_HOOKS_HEADER
+#endif
+
+static inline void RTOS_hookThread(RTOS_thread_t * pThread)
+{
+	(void) pThread;
+}
+
+static inline void RTOS_hookThreadObject(RTOS_thread_t * pThread, void * pObject)
+{
+	(void) pThread;
+	(void) pObject;
+}
+
+static inline void RTOS_hookNone(void)
+{
+
+}
+
+static inline void RTOS_hookNumber(uint32_t number)
+{
+	(void) number;
+}
+
+/**
+ * @brief Thread is created, before it is added to the ready list
+ */
+#ifndef RTOS_HOOK_THREAD_CREATED
+#define RTOS_HOOK_THREAD_CREATED(pThread)			RTOS_hookThread(pThread)
+#endif
+
+/**
+ * @brief Thread is destroyed, after it is removed from the kernel lists
+ */
+#ifndef RTOS_HOOK_THREAD_DESTROYED
+#define RTOS_HOOK_THREAD_DESTROYED(pThread)		RTOS_hookThread(pThread)
+#endif
+
+/**
+ * @brief Thread is switched in by PendSV
+ */
+#ifndef RTOS_HOOK_THREAD_SWITCHED_IN
+#define RTOS_HOOK_THREAD_SWITCHED_IN(pThread)		RTOS_hookThread(pThread)
+#endif
+
+/**
+ * @brief Thread is switched out by PendSV
+ */
+#ifndef RTOS_HOOK_THREAD_SWITCHED_OUT
+#define RTOS_HOOK_THREAD_SWITCHED_OUT(pThread)		RTOS_hookThread(pThread)
+#endif
+
+/**
+ * @brief Running thread blocks, the waiting list identifies the object
+ */
+#ifndef RTOS_HOOK_THREAD_BLOCKED
+#define RTOS_HOOK_THREAD_BLOCKED(pThread, pWaitingList)	RTOS_hookThreadObject((pThread), (pWaitingList))
+#endif
+
+/**
+ * @brief Thread is woken up from a waiting list by the object
+ */
+#ifndef RTOS_HOOK_THREAD_WOKEN
+#define RTOS_HOOK_THREAD_WOKEN(pThread, pWaitingList)	RTOS_hookThreadObject((pThread), (pWaitingList))
+#endif
+
+/**
+ * @brief Delay or wait time of a thread expires
+ */
+#ifndef RTOS_HOOK_TIMER_EXPIRED
+#define RTOS_HOOK_TIMER_EXPIRED(pThread)			RTOS_hookThread(pThread)
+#endif
+
+/**
+ * @brief SVC call is dispatched
+ */
+#ifndef RTOS_HOOK_SVC_ENTER
+#define RTOS_HOOK_SVC_ENTER(svcNumber)				RTOS_hookNumber(svcNumber)
+#endif
+
+/**
+ * @brief SVC call returns
+ */
+#ifndef RTOS_HOOK_SVC_EXIT
+#define RTOS_HOOK_SVC_EXIT(svcNumber)				RTOS_hookNumber(svcNumber)
+#endif
+
+/**
+ * @brief Idle thread is switched in
+ */
+#ifndef RTOS_HOOK_IDLE_ENTER
+#define RTOS_HOOK_IDLE_ENTER()						RTOS_hookNone()
+#endif
+
+/**
+ * @brief Idle thread is switched out
+ */
+#ifndef RTOS_HOOK_IDLE_EXIT
+#define RTOS_HOOK_IDLE_EXIT()						RTOS_hookNone()
+#endif
+
+#endif /* INC_RTOS_HOOKS_H_ */
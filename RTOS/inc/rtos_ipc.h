@@ -0,0 +1,39 @@
+/*
+ * rtos_ipc.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_IPC_H_
+#define INC_RTOS_IPC_H_
+
+/**
+ * @brief Message words passed in r1 to r3 of a call or a reply
+ */
+#define IPC_MESSAGE_WORDS		((uint32_t) 3u)
+
+typedef struct
+{
+	uint32_t data[IPC_MESSAGE_WORDS];
+} RTOS_ipcMessage_t;
+
+typedef struct endpoint_t
+{
+	RTOS_thread_t * pOwner;			/* Server thread of the endpoint */
+	RTOS_thread_t * pServer;		/* Server waiting for a call, NULL if it is busy */
+	RTOS_list_t callersList;		/* Clients waiting for the server, in priority order */
+} RTOS_endpoint_t;
+
+void RTOS_endpointCreate(RTOS_endpoint_t * pEndpoint);
+void RTOS_SVC_endpointCreate(RTOS_endpoint_t * pEndpoint);
+
+void RTOS_ipcCall(RTOS_endpoint_t * pEndpoint, uint32_t * pFrame);
+uint32_t RTOS_SVC_call(RTOS_endpoint_t * pEndpoint, RTOS_ipcMessage_t * pMessage);
+
+void RTOS_ipcReplyWait(RTOS_endpoint_t * pEndpoint, uint32_t * pFrame);
+uint32_t RTOS_SVC_replyWait(RTOS_endpoint_t * pEndpoint, RTOS_ipcMessage_t * pMessage);
+
+void RTOS_ipcReleaseThread(RTOS_thread_t * pThread);
+
+#endif /* INC_RTOS_IPC_H_ */
@@ -30,6 +30,7 @@ typedef struct
 typedef struct
 {
 	uint32_t numOfItems;			/* Number of threads items in the list */
+	uint32_t maxNumOfItems;			/* Most items, counted by RTOS_listInsert with KERNEL_STATS_ENABLE */
 	RTOS_listItem_t * pIndex;		/* Pointer to the current item */
 	RTOS_listEnd_t listEnd;			/* List end*/
 } RTOS_list_t;
@@ -39,5 +40,6 @@ void RTOS_listInit(RTOS_list_t * pList);
 void RTOS_listInsertEnd(RTOS_list_t * pList, RTOS_listItem_t * pItem);
 void RTOS_listRemove(RTOS_listItem_t * pItem);
 void RTOS_listInsert(RTOS_list_t * pList, RTOS_listItem_t * pItem);
+uint32_t RTOS_listGetHighWater(const RTOS_list_t * pList);
 
 #endif /* INC_RTOS_LIST_H_ */
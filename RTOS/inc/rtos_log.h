@@ -0,0 +1,126 @@
+/*
+ * rtos_log.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_LOG_H_
+#define INC_RTOS_LOG_H_
+
+/**
+ * @brief Marks the log buffer in a RAM dump, "LOGB"
+ */
+#define LOG_MAGIC				((uint32_t) 0x4C4F4742u)
+
+/**
+ * @brief Arguments stored with each log record
+ */
+#define LOG_MAX_ARGS			((uint32_t) 4u)
+
+typedef struct
+{
+	volatile uint32_t sequence;		/* Write count of the record plus one, set last to commit the record */
+	uint32_t timestamp;				/* System tick */
+	uint32_t header;				/* Arguments number in bits 31:24, running thread ID in bits 23:0 */
+	const char * pFormat;			/* Format string, never copied */
+	uint32_t args[LOG_MAX_ARGS];
+} RTOS_logRecord_t;
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t tickRateHz;
+	uint32_t recordsNum;
+	volatile uint32_t writeCount;	/* Records reserved since init, the ring index is taken modulo recordsNum */
+	volatile uint32_t readCount;	/* Records consumed by RTOS_logGet, stays 0 with LOG_OVERWRITE */
+	volatile uint32_t droppedCount;	/* Records dropped because the ring was full, stays 0 with LOG_OVERWRITE */
+	RTOS_logRecord_t records[LOG_BUFFER_RECORDS];
+} RTOS_logBuffer_t;
+
+#if (LOG_ENABLE == 1)
+
+extern RTOS_logBuffer_t RTOS_logBuffer;
+
+void RTOS_logInit(void);
+#if (LOG_OVERWRITE == 0)
+uint32_t RTOS_logGet(RTOS_logRecord_t * pRecord);
+#endif
+
+/**
+ * @brief Records a log message, safe to call from threads and from any interrupt priority.
+ *
+ * Only the format string address and the raw arguments are stored, formatting
+ * is left to the consumer of the ring. A record is reserved with LDREX/STREX,
+ * filled, then committed by its sequence number. When the ring is full the
+ * newest record is dropped, or with LOG_OVERWRITE the oldest is overwritten.
+ *
+ * @param pFormat Format string, must stay valid, e.g. a string literal.
+ * @param argsNum Number of valid arguments.
+ *
+ */
+static inline void RTOS_logRecord(const char * pFormat, uint32_t argsNum,
+		uint32_t arg0, uint32_t arg1, uint32_t arg2, uint32_t arg3)
+{
+	RTOS_thread_t * pRunningThread = RTOS_threadGetRunning();
+	RTOS_logRecord_t * pRecord;
+	uint32_t index;
+#if (LOG_OVERWRITE == 0)
+	uint32_t dropped;
+#endif
+
+	do
+	{
+		index = __LDREXW(&RTOS_logBuffer.writeCount);
+#if (LOG_OVERWRITE == 0)
+		if((index - RTOS_logBuffer.readCount) >= LOG_BUFFER_RECORDS)
+		{
+			__CLREX();
+			do
+			{
+				dropped = __LDREXW(&RTOS_logBuffer.droppedCount);
+			}while(__STREXW(dropped + 1, &RTOS_logBuffer.droppedCount) != 0);
+			return;
+		}
+#endif
+	}while(__STREXW(index + 1, &RTOS_logBuffer.writeCount) != 0);
+
+	pRecord = &RTOS_logBuffer.records[index & (LOG_BUFFER_RECORDS - 1)];
+	pRecord->timestamp = RTOS_threadGetTickCount();
+	pRecord->header = (argsNum << 24)
+			| ((pRunningThread != NULL) ? (pRunningThread->threadID & 0xFFFFFF) : 0);
+	pRecord->pFormat = pFormat;
+	pRecord->args[0] = arg0;
+	pRecord->args[1] = arg1;
+	pRecord->args[2] = arg2;
+	pRecord->args[3] = arg3;
+
+	/* Record is complete before it is committed */
+	__DMB();
+	pRecord->sequence = index + 1;
+}
+
+/* Counts the arguments, a fifth argument expands to an undeclared identifier */
+#define LOG_ARGS_NUM(...)				LOG_ARGS_NUM_(0, ##__VA_ARGS__, RTOS_LOG_takes_at_most_4_arguments, 4, 3, 2, 1, 0)
+#define LOG_ARGS_NUM_(_0, _1, _2, _3, _4, _5, N, ...)	N
+
+/* Pads the arguments with zeros up to LOG_MAX_ARGS */
+#define LOG_ARGS_PAD(...)				LOG_ARGS_PAD_(0, ##__VA_ARGS__, 0, 0, 0, 0, 0)
+#define LOG_ARGS_PAD_(_0, _1, _2, _3, _4, ...)	_1, _2, _3, _4
+
+/**
+ * @brief Logs up to 4 integer or pointer arguments, e.g. RTOS_LOG("x=%d\n", x).
+ *
+ * Every argument is stored as 32 bits, so 64-bit and floating point conversions
+ * are not supported. Pointer arguments must be cast to uint32_t, %s arguments
+ * must point to strings that outlive the record.
+ */
+#define RTOS_LOG(pFormat, ...)		RTOS_logRecord((pFormat), LOG_ARGS_NUM(__VA_ARGS__), LOG_ARGS_PAD(__VA_ARGS__))
+
+#else
+
+#define RTOS_LOG(pFormat, ...)
+
+#endif
+
+#endif /* INC_RTOS_LOG_H_ */
@@ -8,6 +8,8 @@
 #ifndef INC_RTOS_MAILBOX_H_
 #define INC_RTOS_MAILBOX_H_
 
+struct queueSet_t;
+
 typedef struct
 {
   int8_t * pStart;
@@ -18,6 +20,7 @@ typedef struct
   uint32_t messageSize;
   uint32_t messagesNum;
   RTOS_list_t waitingList;
+  struct queueSet_t * pQueueSet;
 } RTOS_mailbox_t;
 
 void RTOS_mailboxCreate(RTOS_mailbox_t * pMailbox, void * pBuffer,
@@ -0,0 +1,60 @@
+/*
+ * rtos_msgqueue.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_MSGQUEUE_H_
+#define INC_RTOS_MSGQUEUE_H_
+
+/**
+ * @brief Bytes of queue buffer used by each message, the message is stored
+ * after the index of the next slot and padded to a word
+ */
+#define MSG_QUEUE_SLOT_SIZE(messageSize)	((uint32_t) (sizeof(uint32_t) + (((messageSize) + 3u) & ~3u)))
+
+/**
+ * @brief Slot index of an empty chain
+ */
+#define MSG_QUEUE_NO_SLOT		((uint32_t) 0xFFFFFFFFu)
+
+typedef struct
+{
+	uint8_t * pBuffer;
+	uint32_t messageSize;
+	uint32_t slotSize;
+	uint32_t slotsNum;
+	uint32_t messagesNum;
+	uint32_t freeSlot;									/* First slot of the free chain */
+	uint32_t head[MSG_QUEUE_PRIORITY_LEVELS];			/* First message of each priority */
+	uint32_t tail[MSG_QUEUE_PRIORITY_LEVELS];			/* Last message of each priority */
+	uint32_t readyLevels;								/* Bit n is set if priority n has messages */
+	RTOS_list_t sendersWaitingList;
+	RTOS_list_t receiversWaitingList;
+} RTOS_msgQueue_t;
+
+void RTOS_msgQueueCreate(RTOS_msgQueue_t * pQueue, void * pBuffer,
+		uint32_t bufferLength, uint32_t messageSize);
+void RTOS_SVC_msgQueueCreate(RTOS_msgQueue_t * pQueue, void * pBuffer,
+		uint32_t bufferLength, uint32_t messageSize);
+
+uint32_t RTOS_msgQueueSend(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		const void * pMessage, uint32_t priority);
+uint32_t RTOS_SVC_msgQueueSend(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		const void * pMessage, uint32_t priority);
+
+uint32_t RTOS_msgQueueSendToFront(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		const void * pMessage, uint32_t priority);
+uint32_t RTOS_SVC_msgQueueSendToFront(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		const void * pMessage, uint32_t priority);
+
+uint32_t RTOS_msgQueueSendFromISR(RTOS_msgQueue_t * pQueue, const void * pMessage,
+		uint32_t priority);
+
+uint32_t RTOS_msgQueueReceive(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		void * pMessage, uint32_t * pPriority);
+uint32_t RTOS_SVC_msgQueueReceive(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		void * pMessage, uint32_t * pPriority);
+
+#endif /* INC_RTOS_MSGQUEUE_H_ */
@@ -8,15 +8,23 @@
 #ifndef INC_RTOS_MUTEX_H_
 #define INC_RTOS_MUTEX_H_
 
-typedef struct
+typedef struct mutex_t
 {
 	uint32_t mutexValue;
+	uint32_t recursive;				/* 1 if the owner can lock the mutex again */
+	uint32_t lockCount;				/* Nesting count of the owner */
+	uint32_t ownerDied;				/* 1 if the owner was destroyed while holding the mutex */
+	RTOS_thread_t * pOwner;			/* Thread holding the mutex */
+	struct mutex_t * pNextOwned;	/* Next mutex held by the same owner */
 	RTOS_list_t waitingList;
 } RTOS_mutex_t;
 
 void RTOS_mutexCreate(RTOS_mutex_t * pMutex, uint32_t initialValue);
 void RTOS_SVC_mutexCreate(RTOS_mutex_t * pMutex, uint32_t initialValue);
 
+void RTOS_mutexCreateRecursive(RTOS_mutex_t * pMutex);
+void RTOS_SVC_mutexCreateRecursive(RTOS_mutex_t * pMutex);
+
 
 uint32_t RTOS_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime);
 uint32_t RTOS_SVC_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime);
@@ -25,5 +33,7 @@ uint32_t RTOS_SVC_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime);
 void RTOS_mutexRelease(RTOS_mutex_t * pMutex);
 void RTOS_SVC_mutexRelease(RTOS_mutex_t * pMutex);
 
+void RTOS_mutexReleaseOwned(RTOS_thread_t * pThread);
+
 
 #endif /* INC_RTOS_MUTEX_H_ */
@@ -0,0 +1,44 @@
+/*
+ * rtos_queueset.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_QUEUESET_H_
+#define INC_RTOS_QUEUESET_H_
+
+typedef enum
+{
+	RTOS_QUEUE_SET_SEMAPHORE,
+	RTOS_QUEUE_SET_MAILBOX,
+	RTOS_QUEUE_SET_STREAM_BUFFER
+} RTOS_queueSetMemberType_t;
+
+typedef struct queueSet_t
+{
+	void * pMembers[QUEUE_SET_MAX_MEMBERS];
+	RTOS_queueSetMemberType_t memberTypes[QUEUE_SET_MAX_MEMBERS];
+	uint32_t membersNum;
+	RTOS_list_t waitingList;
+} RTOS_queueSet_t;
+
+void RTOS_queueSetCreate(RTOS_queueSet_t * pQueueSet);
+void RTOS_SVC_queueSetCreate(RTOS_queueSet_t * pQueueSet);
+
+void RTOS_queueSetAdd(RTOS_queueSet_t * pQueueSet, void * pMember,
+		RTOS_queueSetMemberType_t memberType);
+void RTOS_SVC_queueSetAdd(RTOS_queueSet_t * pQueueSet, void * pMember,
+		RTOS_queueSetMemberType_t memberType);
+
+void RTOS_queueSetRemove(RTOS_queueSet_t * pQueueSet, void * pMember);
+void RTOS_SVC_queueSetRemove(RTOS_queueSet_t * pQueueSet, void * pMember);
+
+uint32_t RTOS_queueSetSelect(RTOS_queueSet_t * pQueueSet, int32_t waitTime,
+		void ** ppMember);
+uint32_t RTOS_SVC_queueSetSelect(RTOS_queueSet_t * pQueueSet, int32_t waitTime,
+		void ** ppMember);
+
+void RTOS_queueSetNotify(RTOS_queueSet_t * pQueueSet);
+
+#endif /* INC_RTOS_QUEUESET_H_ */
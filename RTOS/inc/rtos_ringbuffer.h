@@ -0,0 +1,34 @@
+/*
+ * rtos_ringbuffer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_RINGBUFFER_H_
+#define INC_RTOS_RINGBUFFER_H_
+
+typedef struct
+{
+	uint8_t * pBuffer;
+	uint32_t size;						/* Buffer size in bytes, power of two */
+	volatile uint32_t writeCount;		/* Bytes committed by the producer, wraps around */
+	volatile uint32_t readCount;		/* Bytes consumed by the consumer, wraps around */
+	uint32_t watermark;					/* Used bytes that notify the consumer */
+	RTOS_semaphore_t * pNotify;			/* Semaphore given when the watermark is reached */
+} RTOS_ringBuffer_t;
+
+void RTOS_ringBufferCreate(RTOS_ringBuffer_t * pRingBuffer, void * pBuffer, uint32_t size,
+		RTOS_semaphore_t * pNotify, uint32_t watermark);
+
+uint32_t RTOS_ringBufferGetWriteSpan(RTOS_ringBuffer_t * pRingBuffer, uint8_t ** ppSpan);
+void RTOS_ringBufferCommit(RTOS_ringBuffer_t * pRingBuffer, uint32_t length);
+uint32_t RTOS_ringBufferWrite(RTOS_ringBuffer_t * pRingBuffer, const void * pData, uint32_t length);
+
+uint32_t RTOS_ringBufferGetReadSpan(RTOS_ringBuffer_t * pRingBuffer, uint8_t ** ppSpan);
+void RTOS_ringBufferConsume(RTOS_ringBuffer_t * pRingBuffer, uint32_t length);
+uint32_t RTOS_ringBufferRead(RTOS_ringBuffer_t * pRingBuffer, void * pData, uint32_t length);
+
+uint32_t RTOS_ringBufferGetUsed(const RTOS_ringBuffer_t * pRingBuffer);
+
+#endif /* INC_RTOS_RINGBUFFER_H_ */
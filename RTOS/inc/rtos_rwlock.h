@@ -0,0 +1,47 @@
+/*
+ * rtos_rwlock.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_RWLOCK_H_
+#define INC_RTOS_RWLOCK_H_
+
+/**
+ * @brief Lock state bits, the low half word counts the readers holding the lock
+ */
+#define RWLOCK_READERS_MASK			((uint32_t) 0x0000FFFFu)
+#define RWLOCK_WRITER				((uint32_t) 0x00010000u)
+#define RWLOCK_WRITER_WAITING		((uint32_t) 0x00020000u)
+#define RWLOCK_WAITERS				((uint32_t) 0x00040000u)
+
+typedef struct rwlock_t
+{
+	uint32_t lockState;
+	RTOS_thread_t * pWriter;
+	RTOS_list_t readersWaitingList;
+	RTOS_list_t writersWaitingList;
+} RTOS_rwlock_t;
+
+void RTOS_rwlockCreate(RTOS_rwlock_t * pRwlock);
+void RTOS_SVC_rwlockCreate(RTOS_rwlock_t * pRwlock);
+
+uint32_t RTOS_rwlockReadLock(RTOS_rwlock_t * pRwlock, int32_t waitTime);
+uint32_t RTOS_SVC_rwlockReadLock(RTOS_rwlock_t * pRwlock, int32_t waitTime);
+
+void RTOS_rwlockReadUnlock(RTOS_rwlock_t * pRwlock);
+void RTOS_SVC_rwlockReadUnlock(RTOS_rwlock_t * pRwlock);
+
+uint32_t RTOS_rwlockWriteLock(RTOS_rwlock_t * pRwlock, int32_t waitTime);
+uint32_t RTOS_SVC_rwlockWriteLock(RTOS_rwlock_t * pRwlock, int32_t waitTime);
+
+void RTOS_rwlockWriteUnlock(RTOS_rwlock_t * pRwlock);
+void RTOS_SVC_rwlockWriteUnlock(RTOS_rwlock_t * pRwlock);
+
+void RTOS_rwlockReleaseThread(RTOS_thread_t * pThread);
+
+uint32_t RTOS_rwlockAcquireRead(RTOS_rwlock_t * pRwlock, int32_t waitTime);
+void RTOS_rwlockReleaseRead(RTOS_rwlock_t * pRwlock);
+
+#endif /* INC_RTOS_RWLOCK_H_ */
@@ -8,10 +8,13 @@
 #ifndef INC_RTOS_SEMAPHORE_H_
 #define INC_RTOS_SEMAPHORE_H_
 
+struct queueSet_t;
+
 typedef struct
 {
 	uint32_t semaphoreValue;
 	RTOS_list_t waitingList;
+	struct queueSet_t * pQueueSet;
 }RTOS_semaphore_t;
 
 void RTOS_semaphoreCreate(RTOS_semaphore_t * pSemaphore, uint32_t initialValue);
@@ -22,5 +25,6 @@ uint32_t RTOS_SVC_semaphoreTake(RTOS_semaphore_t * pSemaphore, int32_t waitTime)
 
 void RTOS_semaphoreGive(RTOS_semaphore_t * pSemaphore);
 void RTOS_SVC_semaphoreGive(RTOS_semaphore_t * pSemaphore);
+void RTOS_semaphoreGiveFromISR(RTOS_semaphore_t * pSemaphore);
 
 #endif /* INC_RTOS_SEMAPHORE_H_ */
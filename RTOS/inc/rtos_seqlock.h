@@ -0,0 +1,27 @@
+/*
+ * rtos_seqlock.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_SEQLOCK_H_
+#define INC_RTOS_SEQLOCK_H_
+
+typedef struct
+{
+	volatile uint32_t sequence;		/* Odd while a write is in progress */
+} RTOS_seqlock_t;
+
+void RTOS_seqlockCreate(RTOS_seqlock_t * pSeqlock);
+
+void RTOS_seqlockWriteBegin(RTOS_seqlock_t * pSeqlock);
+void RTOS_seqlockWriteEnd(RTOS_seqlock_t * pSeqlock);
+void RTOS_seqlockWrite(RTOS_seqlock_t * pSeqlock, void * pData, const void * pSource, uint32_t size);
+void RTOS_seqlockWriteFromISR(RTOS_seqlock_t * pSeqlock, void * pData, const void * pSource, uint32_t size);
+
+uint32_t RTOS_seqlockReadBegin(const RTOS_seqlock_t * pSeqlock);
+uint32_t RTOS_seqlockReadRetry(const RTOS_seqlock_t * pSeqlock, uint32_t sequence);
+void RTOS_seqlockRead(const RTOS_seqlock_t * pSeqlock, void * pDestination, const void * pData, uint32_t size);
+
+#endif /* INC_RTOS_SEQLOCK_H_ */
@@ -0,0 +1,51 @@
+/*
+ * rtos_stats.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_STATS_H_
+#define INC_RTOS_STATS_H_
+
+/**
+ * @brief SVC numbers counted by the kernel statistics
+ */
+#define KERNEL_STATS_SVC_NUMBERS	((uint32_t) 64u)
+
+typedef struct
+{
+	uint32_t svcCalls[KERNEL_STATS_SVC_NUMBERS];	/* Calls of each SVC number */
+	uint32_t contextSwitches;						/* Switches to another thread */
+	uint32_t timerListHighWater;					/* Most threads in the timer list */
+	uint32_t waitingListHighWater;					/* Most threads in the waiting list of one object */
+	uint32_t maxWokenPerTick;						/* Most threads woken up by the timer list in one tick */
+	uint32_t maxCriticalSection;					/* Longest kernel critical section in cycles */
+} RTOS_kernelStats_t;
+
+#if (KERNEL_STATS_ENABLE == 1)
+
+extern RTOS_kernelStats_t RTOS_kernelStats;
+
+#define KERNEL_STATS_COUNT(counter)				(RTOS_kernelStats.counter++)
+#define KERNEL_STATS_MAX(counter, value)		do { uint32_t statsValue = (value); \
+		if(statsValue > RTOS_kernelStats.counter) { RTOS_kernelStats.counter = statsValue; } } while(0)
+
+/* Time a critical section for maxCriticalSection, END is called before the
+ * section is left */
+#define KERNEL_STATS_SECTION_START(start)		uint32_t start = DWT->CYCCNT
+#define KERNEL_STATS_SECTION_END(start)			KERNEL_STATS_MAX(maxCriticalSection, DWT->CYCCNT - (start))
+
+#else
+
+#define KERNEL_STATS_COUNT(counter)
+#define KERNEL_STATS_MAX(counter, value)
+#define KERNEL_STATS_SECTION_START(start)
+#define KERNEL_STATS_SECTION_END(start)
+
+#endif
+
+void RTOS_getKernelStats(RTOS_kernelStats_t * pStats);
+void RTOS_SVC_getKernelStats(RTOS_kernelStats_t * pStats);
+
+#endif /* INC_RTOS_STATS_H_ */
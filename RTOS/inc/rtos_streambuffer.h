@@ -0,0 +1,56 @@
+/*
+ * rtos_streambuffer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_STREAMBUFFER_H_
+#define INC_RTOS_STREAMBUFFER_H_
+
+/**
+ * @brief Size of the length prefix of each message in a message buffer
+ */
+#define MESSAGE_BUFFER_HEADER_SIZE	((uint32_t) sizeof(uint32_t))
+
+struct queueSet_t;
+
+typedef struct
+{
+	uint8_t * pBuffer;
+	uint32_t bufferLength;			/* Buffer length in bytes */
+	uint32_t readIndex;
+	uint32_t writeIndex;
+	uint32_t usedLength;			/* Bytes in the buffer, including message prefixes */
+	uint32_t triggerLevel;			/* Bytes that wake up a waiting reader */
+	uint32_t isMessageBuffer;		/* 1 if the data is sent and received as whole messages */
+	RTOS_list_t readersWaitingList;
+	RTOS_list_t writersWaitingList;
+	struct queueSet_t * pQueueSet;
+} RTOS_streamBuffer_t;
+
+typedef RTOS_streamBuffer_t RTOS_messageBuffer_t;
+
+void RTOS_streamBufferCreate(RTOS_streamBuffer_t * pStreamBuffer, void * pBuffer,
+		uint32_t bufferLength, uint32_t triggerLevel);
+void RTOS_SVC_streamBufferCreate(RTOS_streamBuffer_t * pStreamBuffer, void * pBuffer,
+		uint32_t bufferLength, uint32_t triggerLevel);
+
+void RTOS_messageBufferCreate(RTOS_messageBuffer_t * pMessageBuffer, void * pBuffer,
+		uint32_t bufferLength);
+void RTOS_SVC_messageBufferCreate(RTOS_messageBuffer_t * pMessageBuffer, void * pBuffer,
+		uint32_t bufferLength);
+
+uint32_t RTOS_streamBufferSend(RTOS_streamBuffer_t * pStreamBuffer, int32_t waitTime,
+		const void * pData, uint32_t length);
+uint32_t RTOS_SVC_streamBufferSend(RTOS_streamBuffer_t * pStreamBuffer, int32_t waitTime,
+		const void * pData, uint32_t length);
+uint32_t RTOS_streamBufferSendFromISR(RTOS_streamBuffer_t * pStreamBuffer,
+		const void * pData, uint32_t length);
+
+uint32_t RTOS_streamBufferReceive(RTOS_streamBuffer_t * pStreamBuffer, int32_t waitTime,
+		void * pData, uint32_t length, uint32_t * pReceivedLength);
+uint32_t RTOS_SVC_streamBufferReceive(RTOS_streamBuffer_t * pStreamBuffer, int32_t waitTime,
+		void * pData, uint32_t length);
+
+#endif /* INC_RTOS_STREAMBUFFER_H_ */
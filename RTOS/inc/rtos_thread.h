@@ -10,13 +10,54 @@
 
 #include "rtos_config.h"
 
+typedef void (* RTOS_threadFunction_t)(void * pArg);
+
+struct mutex_t;
+struct endpoint_t;
+
+typedef struct
+{
+	uint64_t runTime;				/* Cycles spent running */
+	uint64_t blockedTime;			/* Cycles spent blocked, delayed or suspended */
+	uint32_t switchCount;			/* Times switched in */
+	uint32_t preemptCount;			/* Times switched out while still ready */
+	uint64_t blockedSince;			/* 64-bit cycle counter when the thread was switched out blocked */
+	uint32_t blocked;				/* 1 while the thread is blocked */
+} RTOS_threadStats_t;
+
+typedef struct
+{
+	uint64_t runTime;				/* Cycles spent running */
+	uint64_t blockedTime;			/* Cycles spent blocked, delayed or suspended */
+	uint32_t switchCount;			/* Times switched in */
+	uint32_t preemptCount;			/* Times switched out while still ready */
+	uint32_t cpuLoad;				/* Share of the CPU time used by the thread in per mille */
+	uint32_t systemLoad;			/* Share of the CPU time not used by the idle thread in per mille */
+} RTOS_threadStatsReport_t;
+
 typedef struct thread_t
 {
 	uint32_t pStackPointer;
 	uint32_t priority;
 	uint32_t threadID;
+	uint32_t preemptionThreshold;	/* Only threads above this priority preempt the thread */
+	uint32_t schedulerLockCount;	/* Nesting count of the scheduler lock */
+	uint32_t relativeDeadline;		/* EDF deadline in ticks, counted from each release */
+	uint32_t absoluteDeadline;		/* EDF deadline tick of the current release */
 	RTOS_listItem_t listItem;
 	RTOS_listItem_t eventListItem;
+	RTOS_list_t joinList;			/* Threads waiting for this thread to terminate */
+	uint32_t terminated;			/* 1 when the thread is destroyed */
+	struct mutex_t * pOwnedMutexes;	/* Mutexes held by the thread */
+	struct mutex_t * pCondvarMutex;	/* Mutex to lock again after a condition variable wait */
+	struct rwlock_t * pHandoverRwlock;	/* Reader-writer lock handed over before the write lock retry */
+	uint32_t condvarState;			/* Condition variable wait state */
+	uint32_t * pIpcFrame;			/* SVC frame of a thread waiting in an IPC call */
+	struct thread_t * pIpcClient;	/* Client being served by the thread */
+	struct thread_t * pIpcServer;	/* Server serving the call of the thread */
+	struct endpoint_t * pIpcEndpoint;	/* Endpoint served by the thread */
+	uint32_t ipcBasePriority;		/* Server priority restored after each reply */
+	RTOS_threadStats_t stats;		/* Run time accounting */
 } RTOS_thread_t;
 
 typedef struct
@@ -25,16 +66,46 @@ typedef struct
 } RTOS_stack_t;
 
 void RTOS_threadInitLists(void);
-void RTOS_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t priority, void * pFunction);
-void RTOS_SVC_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t priority, void * pFunction);
+void RTOS_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t priority,
+		RTOS_threadFunction_t pFunction, void * pArg);
+void RTOS_SVC_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t priority,
+		RTOS_threadFunction_t pFunction, void * pArg);
 RTOS_thread_t * RTOS_threadGetCurrentReady(void);
 void RTOS_threadSwitchRunning(void);
 RTOS_thread_t * RTOS_threadGetRunning(void);
 void RTOS_threadAddToReadyList(RTOS_thread_t * pThread);
+void RTOS_threadHandoff(RTOS_thread_t * pThread);
+void RTOS_threadSetIdle(RTOS_thread_t * pThread);
+void RTOS_threadYield(void);
+void RTOS_SVC_threadYield(void);
 void RTOS_threadRefreshTimerList(void);
+uint32_t RTOS_threadGetTickCount(void);
+void RTOS_threadUpdateTimeSlice(void);
+void RTOS_threadSetTimeSlice(uint32_t priority, uint32_t ticks);
+void RTOS_SVC_threadSetTimeSlice(uint32_t priority, uint32_t ticks);
 void RTOS_threadAddRunningToTimerList(uint32_t waitTime);
+void RTOS_threadBlockRunning(RTOS_list_t * pWaitingList, int32_t waitTime);
+RTOS_thread_t * RTOS_threadWakeUpWaiting(RTOS_list_t * pWaitingList);
 void RTOS_threadDestroy(RTOS_thread_t * pThread);
 void RTOS_SVC_threadDestroy(RTOS_thread_t * pThread);
 void RTOS_SVC_threadDelay(uint32_t waitTime);
+uint32_t RTOS_threadJoin(RTOS_thread_t * pThread, int32_t waitTime);
+uint32_t RTOS_SVC_threadJoin(RTOS_thread_t * pThread, int32_t waitTime);
+void RTOS_threadSetPriority(RTOS_thread_t * pThread, uint32_t priority);
+void RTOS_SVC_threadSetPriority(RTOS_thread_t * pThread, uint32_t priority);
+void RTOS_threadSuspend(RTOS_thread_t * pThread);
+void RTOS_SVC_threadSuspend(RTOS_thread_t * pThread);
+void RTOS_threadResume(RTOS_thread_t * pThread);
+void RTOS_SVC_threadResume(RTOS_thread_t * pThread);
+void RTOS_threadSetPreemptionThreshold(RTOS_thread_t * pThread, uint32_t preemptionThreshold);
+void RTOS_SVC_threadSetPreemptionThreshold(RTOS_thread_t * pThread, uint32_t preemptionThreshold);
+void RTOS_schedulerLock(void);
+void RTOS_SVC_schedulerLock(void);
+void RTOS_schedulerUnlock(void);
+void RTOS_SVC_schedulerUnlock(void);
+void RTOS_threadSetDeadline(RTOS_thread_t * pThread, uint32_t relativeDeadline);
+void RTOS_threadGetStats(RTOS_thread_t * pThread, RTOS_threadStatsReport_t * pReport);
+uint64_t RTOS_threadGetStatsClock(void);
+void RTOS_SVC_threadSetDeadline(RTOS_thread_t * pThread, uint32_t relativeDeadline);
 
 #endif /* INC_RTOS_THREAD_H_ */
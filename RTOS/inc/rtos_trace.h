@@ -0,0 +1,93 @@
+/*
+ * rtos_trace.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef INC_RTOS_TRACE_H_
+#define INC_RTOS_TRACE_H_
+
+/**
+ * @brief Marks the trace buffer in a RAM dump, "TRCE"
+ */
+#define TRACE_MAGIC				((uint32_t) 0x54524345u)
+
+typedef enum
+{
+	TRACE_EVENT_THREAD_SWITCH,		/* Object is the ID of the switched in thread */
+	TRACE_EVENT_THREAD_READY,		/* Object is the ID of the ready thread */
+	TRACE_EVENT_THREAD_BLOCK,		/* Object is the waiting list */
+	TRACE_EVENT_TIMER_EXPIRE,		/* Object is the ID of the woken thread */
+	TRACE_EVENT_SVC,				/* Object is the SVC number */
+	TRACE_EVENT_MUTEX_LOCK,
+	TRACE_EVENT_MUTEX_RELEASE,
+	TRACE_EVENT_SEMAPHORE_TAKE,
+	TRACE_EVENT_SEMAPHORE_GIVE,
+	TRACE_EVENT_MAILBOX_WRITE,
+	TRACE_EVENT_MAILBOX_READ
+} RTOS_traceEventType_t;
+
+typedef struct
+{
+	uint32_t timestamp;				/* DWT cycle counter */
+	uint32_t header;				/* Event type in bits 31:24, running thread ID in bits 23:0 */
+	uint32_t object;
+} RTOS_traceEvent_t;
+
+typedef struct
+{
+	uint32_t magic;
+	uint32_t clockHz;
+	uint32_t eventsNum;
+	volatile uint32_t writeCount;	/* Events recorded since init, the ring index is taken modulo eventsNum */
+	RTOS_traceEvent_t events[TRACE_BUFFER_EVENTS];
+} RTOS_traceBuffer_t;
+
+#if (TRACE_ENABLE == 1)
+
+extern RTOS_traceBuffer_t RTOS_traceBuffer;
+
+void RTOS_traceInit(void);
+
+/**
+ * @brief Records a trace event, safe to call from any interrupt priority.
+ *
+ * A ring slot is reserved with LDREX/STREX, then filled. The timestamp is read
+ * inside the reservation, an interrupt in between fails the store and the slot
+ * is reserved again, so timestamps follow the ring order. The oldest events are
+ * overwritten.
+ *
+ * @param eventType Type of the event.
+ * @param object Object of the event.
+ *
+ */
+static inline void RTOS_traceRecord(RTOS_traceEventType_t eventType, uint32_t object)
+{
+	RTOS_thread_t * pRunningThread = RTOS_threadGetRunning();
+	RTOS_traceEvent_t * pEvent;
+	uint32_t index;
+	uint32_t timestamp;
+
+	do
+	{
+		index = __LDREXW(&RTOS_traceBuffer.writeCount);
+		timestamp = DWT->CYCCNT;
+	}while(__STREXW(index + 1, &RTOS_traceBuffer.writeCount) != 0);
+
+	pEvent = &RTOS_traceBuffer.events[index & (TRACE_BUFFER_EVENTS - 1)];
+	pEvent->timestamp = timestamp;
+	pEvent->header = ((uint32_t) eventType << 24)
+			| ((pRunningThread != NULL) ? (pRunningThread->threadID & 0xFFFFFF) : 0);
+	pEvent->object = object;
+}
+
+#define RTOS_TRACE(eventType, object)	RTOS_traceRecord((eventType), (uint32_t) (object))
+
+#else
+
+#define RTOS_TRACE(eventType, object)
+
+#endif
+
+#endif /* INC_RTOS_TRACE_H_ */
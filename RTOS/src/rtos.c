@@ -13,9 +13,10 @@ static RTOS_stack_t idleThreadStack;
 uint32_t svcEXEReturn;
 static uint32_t schedulerRunning = 0;
 
-static void idleThreadFunction(void);
+static void idleThreadFunction(void * pArg);
+static uint32_t * getStackedArgs(uint32_t * svc_args);
 
-static void idleThreadFunction(void)
+static void idleThreadFunction(void * pArg)
 {
 	while(1)
 	{
@@ -24,6 +25,41 @@ static void idleThreadFunction(void)
 }
 
 
+/**
+ * @brief Gets the SVC call arguments passed on the caller stack.
+ *
+ * Arguments after the fourth one are above the exception stack frame. The frame is
+ * 8 words, or 26 words with the floating point state, plus one padding word when
+ * bit 9 of the stacked xPSR is set.
+ *
+ * @param svc_args Pointer to the stacked arguments during the SVC exception.
+ *
+ * @return Pointer to the fifth argument of the SVC call.
+ *
+ */
+static uint32_t * getStackedArgs(uint32_t * svc_args)
+{
+	uint32_t * pStackedArgs;
+
+	if((svcEXEReturn & 0x10) == 0)
+	{
+		/* Extended frame */
+		pStackedArgs = svc_args + 26;
+	}else
+	{
+		/* Basic frame */
+		pStackedArgs = svc_args + 8;
+	}
+
+	if((svc_args[7] & (1 << 9)) != 0)
+	{
+		/* Frame aligned with a padding word */
+		pStackedArgs++;
+	}
+
+	return pStackedArgs;
+}
+
 /**
  * @brief Initializes the RTOS core and configures the system for multitasking.
  *
@@ -65,6 +101,23 @@ void RTOS_init(void)
 	/* Initialize thread module */
 	RTOS_threadInitLists();
 
+#if (TRACE_ENABLE == 1) || (THREAD_STATS_ENABLE == 1) || (KERNEL_STATS_ENABLE == 1)
+	/* Enable the cycle counter */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+#if (TRACE_ENABLE == 1)
+	/* Start the trace recorder */
+	RTOS_traceInit();
+#endif
+
+#if (LOG_ENABLE == 1)
+	/* Start the deferred log */
+	RTOS_logInit();
+#endif
+
 	/* Enable interrupts */
 	__enable_irq();
 
@@ -80,7 +133,8 @@ void RTOS_init(void)
 void RTOS_schedulerStart(void)
 {
 	/* Create idle thread */
-	RTOS_threadCreate(&idleThread, &idleThreadStack, (THREAD_PRIORITY_LEVELS - 1), idleThreadFunction);
+	RTOS_threadCreate(&idleThread, &idleThreadStack, (THREAD_PRIORITY_LEVELS - 1), idleThreadFunction, NULL);
+	RTOS_threadSetIdle(&idleThread);
 
 	/* Pointer to the current running thread */
 	RTOS_thread_t * pRunningThread;
@@ -128,8 +182,20 @@ void RTOS_SVC_Handler_main(uint32_t * svc_args)
 
 	/* Memory[Stacked PC)-2] */
 	svc_number = ((char *) svc_args[6])[-2];
+	RTOS_TRACE(TRACE_EVENT_SVC, svc_number);
+	RTOS_HOOK_SVC_ENTER(svc_number);
+
+	KERNEL_STATS_SECTION_START(entryCycle);
+
+#if (KERNEL_STATS_ENABLE == 1)
+	if(svc_number < KERNEL_STATS_SVC_NUMBERS)
+	{
+		KERNEL_STATS_COUNT(svcCalls[svc_number]);
+	}
+#endif
 
 	RTOS_return_t returnStatus;
+	uint32_t receivedLength = 0;
 
 	/* Check SVC number */
 	switch(svc_number)
@@ -143,7 +209,8 @@ void RTOS_SVC_Handler_main(uint32_t * svc_args)
 				(RTOS_thread_t *) svc_args[0],
 				(RTOS_stack_t *) svc_args[1],
 				(uint32_t) svc_args[2],
-				(void *) svc_args[3]);
+				(RTOS_threadFunction_t) svc_args[3],
+				(void *) getStackedArgs(svc_args)[0]);
 		break;
 
 	case 2:
@@ -190,6 +257,160 @@ void RTOS_SVC_Handler_main(uint32_t * svc_args)
 		RTOS_threadDestroy((RTOS_thread_t *) svc_args[0]);
 	break;
 
+	case 13:
+		RTOS_threadSetDeadline((RTOS_thread_t *) svc_args[0], (uint32_t) svc_args[1]);
+	break;
+
+	case 14:
+		RTOS_threadSetTimeSlice((uint32_t) svc_args[0], (uint32_t) svc_args[1]);
+	break;
+
+	case 15:
+		RTOS_schedulerLock();
+	break;
+
+	case 16:
+		RTOS_schedulerUnlock();
+	break;
+
+	case 17:
+		RTOS_threadSetPreemptionThreshold((RTOS_thread_t *) svc_args[0], (uint32_t) svc_args[1]);
+	break;
+
+	case 18:
+		returnStatus = RTOS_threadJoin((RTOS_thread_t *) svc_args[0], (int32_t) svc_args[1]);
+	break;
+
+	case 19:
+		RTOS_threadSetPriority((RTOS_thread_t *) svc_args[0], (uint32_t) svc_args[1]);
+	break;
+
+	case 20:
+		RTOS_threadSuspend((RTOS_thread_t *) svc_args[0]);
+	break;
+
+	case 21:
+		RTOS_threadResume((RTOS_thread_t *) svc_args[0]);
+	break;
+
+	case 22:
+		RTOS_mutexCreateRecursive((RTOS_mutex_t *) svc_args[0]);
+	break;
+
+	case 23:
+		RTOS_rwlockCreate((RTOS_rwlock_t *) svc_args[0]);
+	break;
+
+	case 24:
+		returnStatus = RTOS_rwlockReadLock((RTOS_rwlock_t *) svc_args[0], (int32_t) svc_args[1]);
+	break;
+
+	case 25:
+		RTOS_rwlockReadUnlock((RTOS_rwlock_t *) svc_args[0]);
+	break;
+
+	case 26:
+		returnStatus = RTOS_rwlockWriteLock((RTOS_rwlock_t *) svc_args[0], (int32_t) svc_args[1]);
+	break;
+
+	case 27:
+		RTOS_rwlockWriteUnlock((RTOS_rwlock_t *) svc_args[0]);
+	break;
+
+	case 28:
+		RTOS_condvarCreate((RTOS_condvar_t *) svc_args[0]);
+	break;
+
+	case 29:
+		returnStatus = RTOS_condvarWait((RTOS_condvar_t *) svc_args[0], (int32_t) svc_args[1], (RTOS_mutex_t *) svc_args[2]);
+	break;
+
+	case 30:
+		RTOS_condvarSignal((RTOS_condvar_t *) svc_args[0]);
+	break;
+
+	case 31:
+		RTOS_condvarBroadcast((RTOS_condvar_t *) svc_args[0]);
+	break;
+
+	case 32:
+		RTOS_streamBufferCreate((RTOS_streamBuffer_t *) svc_args[0], (void *) svc_args[1], (uint32_t) svc_args[2], (uint32_t) svc_args[3]);
+	break;
+
+	case 33:
+		RTOS_messageBufferCreate((RTOS_messageBuffer_t *) svc_args[0], (void *) svc_args[1], (uint32_t) svc_args[2]);
+	break;
+
+	case 34:
+		returnStatus = RTOS_streamBufferSend((RTOS_streamBuffer_t *) svc_args[0], (int32_t) svc_args[1], (const void *) svc_args[2], (uint32_t) svc_args[3]);
+	break;
+
+	case 35:
+		returnStatus = RTOS_streamBufferReceive((RTOS_streamBuffer_t *) svc_args[0], (int32_t) svc_args[1], (void *) svc_args[2], (uint32_t) svc_args[3], &receivedLength);
+	break;
+
+	case 36:
+		RTOS_queueSetCreate((RTOS_queueSet_t *) svc_args[0]);
+	break;
+
+	case 37:
+		RTOS_queueSetAdd((RTOS_queueSet_t *) svc_args[0], (void *) svc_args[1], (RTOS_queueSetMemberType_t) svc_args[2]);
+	break;
+
+	case 38:
+		RTOS_queueSetRemove((RTOS_queueSet_t *) svc_args[0], (void *) svc_args[1]);
+	break;
+
+	case 39:
+		returnStatus = RTOS_queueSetSelect((RTOS_queueSet_t *) svc_args[0], (int32_t) svc_args[1], (void **) svc_args[2]);
+	break;
+
+	case 40:
+		RTOS_endpointCreate((RTOS_endpoint_t *) svc_args[0]);
+	break;
+
+	case 41:
+		/* Reply is written into the frame by the server */
+		RTOS_ipcCall((RTOS_endpoint_t *) svc_args[0], svc_args);
+	break;
+
+	case 42:
+		/* Next call is written into the frame by the client */
+		RTOS_ipcReplyWait((RTOS_endpoint_t *) svc_args[0], svc_args);
+	break;
+
+	case 43:
+		RTOS_msgQueueCreate((RTOS_msgQueue_t *) svc_args[0], (void *) svc_args[1], (uint32_t) svc_args[2], (uint32_t) svc_args[3]);
+	break;
+
+	case 44:
+		returnStatus = RTOS_msgQueueSend((RTOS_msgQueue_t *) svc_args[0], (int32_t) svc_args[1], (const void *) svc_args[2], (uint32_t) svc_args[3]);
+	break;
+
+	case 45:
+		returnStatus = RTOS_msgQueueSendToFront((RTOS_msgQueue_t *) svc_args[0], (int32_t) svc_args[1], (const void *) svc_args[2], (uint32_t) svc_args[3]);
+	break;
+
+	case 46:
+		returnStatus = RTOS_msgQueueReceive((RTOS_msgQueue_t *) svc_args[0], (int32_t) svc_args[1], (void *) svc_args[2], (uint32_t *) svc_args[3]);
+	break;
+
+	case 47:
+		RTOS_getThreadStats((RTOS_thread_t *) svc_args[0], (RTOS_threadStatsReport_t *) svc_args[1]);
+	break;
+
+	case 48:
+		RTOS_threadYield();
+	break;
+
+	case 49:
+		svc_args[0] = RTOS_getCycleCounter();
+	break;
+
+	case 50:
+		RTOS_getKernelStats((RTOS_kernelStats_t *) svc_args[0]);
+	break;
+
 	default:
 		/* Not supported SVC call */
 		ASSERT(0);
@@ -202,6 +423,15 @@ void RTOS_SVC_Handler_main(uint32_t * svc_args)
 		case 6:
 		case 9:
 		case 10:
+		case 18:
+		case 24:
+		case 26:
+		case 29:
+		case 34:
+		case 39:
+		case 44:
+		case 45:
+		case 46:
 			if(returnStatus == RTOS_CONTEXT_SWITCH_TRIGGERED)
 			{
 				svc_args[6] = svc_args[6] - 2;
@@ -216,28 +446,56 @@ void RTOS_SVC_Handler_main(uint32_t * svc_args)
 			}
 		break;
 
+		case 35:
+			if(returnStatus == RTOS_CONTEXT_SWITCH_TRIGGERED)
+			{
+				svc_args[6] = svc_args[6] - 2;
+				if((int32_t) svc_args[1] > NO_WAIT)
+				{
+					/* Reset waiting time */
+					svc_args[1] = NO_WAIT;
+				}
+			}else
+			{
+				/* Return the received length instead of the status */
+				svc_args[0] = receivedLength;
+			}
+		break;
+
 		default:
 		break;
 	}
 
+	KERNEL_STATS_SECTION_END(entryCycle);
 
+	RTOS_HOOK_SVC_EXIT(svc_number);
 }
 
 /**
  * @brief RTOS SysTick interrupt handler.
  *
  * This function is called on every SysTick interrupt to handle periodic system tasks
- * and trigger a context switch if required.
+ * and trigger a context switch if required. A context switch is only triggered
+ * when a higher priority thread became ready or the time slice of the running
+ * thread expired.
  *
  */
 void RTOS_SysTick_Handler(void)
 {
-	/* Trigger context switch, set PendSV to pending */
-	SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	KERNEL_STATS_SECTION_START(entryCycle);
+
+#if (THREAD_STATS_ENABLE == 1)
+	/* Keep the 64-bit cycle counter from missing a wrap */
+	(void) RTOS_threadGetStatsClock();
+#endif
 
 	/* Increment SysTick counter */
 	RTOS_threadRefreshTimerList();
 
+	/* Consume the running thread time slice */
+	RTOS_threadUpdateTimeSlice();
+
+	KERNEL_STATS_SECTION_END(entryCycle);
 }
 
 /**
@@ -248,3 +506,39 @@ uint32_t RTOS_isSchedulerRunning(void)
 {
 	return schedulerRunning;
 }
+
+/**
+ * @brief Gets the run time statistics of a thread and the system load.
+ *
+ * The system load is derived from the run time of the idle thread.
+ *
+ * @param pThread Pointer to the thread. Must not be NULL.
+ * @param pReport Pointer to the statistics report. Must not be NULL.
+ *
+ */
+void RTOS_getThreadStats(RTOS_thread_t * pThread, RTOS_threadStatsReport_t * pReport)
+{
+	RTOS_threadStatsReport_t idleReport;
+
+	RTOS_threadGetStats(&idleThread, &idleReport);
+	RTOS_threadGetStats(pThread, pReport);
+
+#if (THREAD_STATS_ENABLE == 1)
+	pReport->systemLoad = 1000u - idleReport.cpuLoad;
+#endif
+}
+
+/**
+ * @brief Gets the DWT cycle counter.
+ *
+ * Threads are unprivileged and read it through RTOS_SVC_getCycleCounter.
+ * The counter is started by RTOS_init when the thread statistics, the kernel
+ * statistics or the trace recorder is enabled.
+ *
+ * @return Cycle counter value.
+ *
+ */
+uint32_t RTOS_getCycleCounter(void)
+{
+	return DWT->CYCCNT;
+}
@@ -4,7 +4,8 @@
  *
  * This assembly code implements two interrupt handlers for the RTOS:
  * 1. `RTOS_SVC_Handler`: Handles the Supervisor Call (SVC) interrupt.
- * 2. `RTOS_PendSV_Handler`: Handles the PendSV interrupt.
+ * 2. `RTOS_PendSV_Handler`: Handles the PendSV interrupt. The next thread is selected
+ *    first, the context is only saved and loaded when the running thread changes.
  *
  */
 
@@ -33,7 +34,24 @@ RTOS_SVC_Handler:
 
 .type RTOS_PendSV_Handler, %function
 RTOS_PendSV_Handler:
-/* ******************** */
+    /* ******************** */
+    /* Select next thread   */
+    /* ******************** */
+    push {r4, lr}                /* Save r4 and EXC_RETURN, keeps the stack double word aligned */
+    mov r0, #(1 << 4)            /* Put priority 1 in r0, priority is in bits[7:4] */
+    msr basepri, r0              /* Disable interrupts with priority 1 and greater */
+    bl RTOS_threadGetRunning     /* Get current running thread location */
+    mov r4, r0                   /* Keep the previous running thread in r4 */
+    bl RTOS_threadSwitchRunning  /* Change current running thread */
+    mov r0, #0                   /* Put 0 in r0 */
+    msr basepri, r0              /* Enable interrupts */
+    bl RTOS_threadGetRunning     /* Get next running thread location in r0 */
+    mov r12, r4                  /* Move the previous running thread to r12 */
+    pop {r4, lr}                 /* Restore r4 and EXC_RETURN */
+    cmp r0, r12                  /* Check if the running thread changed */
+    it eq                        /* eq means the same thread is selected */
+    bxeq lr                      /* Return, no context to save or load */
+    /* ******************** */
     /* Save current context */
     /* ******************** */
     mrs r1, psp               /* Store psp in r1 */
@@ -44,17 +62,10 @@ RTOS_PendSV_Handler:
     mrs r3, control           /* Store control in r3 */
     stmdb r1!,{r2-r11}        /* Store multiple registers (r2 to r11).
                                  Decrement address before each access. ! for write back */
-    bl RTOS_threadGetRunning  /* Get current running thread location */
-    str r1,[r0]               /* Store the stack pointer for the current thread  */
+    str r1,[r12]              /* Store the stack pointer for the previous thread */
     /* ******************** */
     /* Load next context    */
     /* ******************** */
-    mov r0, #1                   /* Put 1 in r0 */
-    msr basepri, r0              /* Disable interrupts with priority 1 and greater */
-    bl RTOS_threadSwitchRunning  /* Change current running thread */
-    mov r0, #0                   /* Put 0 in r0 */
-    msr basepri, r0              /* Enable interrupts */
-    bl RTOS_threadGetRunning     /* Get current running thread location */
     ldr r1,[r0]                  /* Get its value which is the stack pointer */
     ldmia r1!,{r2-r11}           /* Load multiple registers (r2 to r11).
                                     Increment address after each access. ! for write back */
@@ -0,0 +1,173 @@
+/*
+ * rtos_condvar.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+static uint32_t signalWaitingThread(RTOS_condvar_t * pCondvar);
+
+/**
+ * @brief Signals the highest priority thread waiting on a condition variable.
+ *
+ * If the mutex of the thread is locked, the thread is moved straight to the mutex
+ * waiting list and runs when the mutex is released. If the mutex is available, the
+ * thread is woken up and locks it.
+ *
+ * @param[in,out] pCondvar Pointer to the condition variable.
+ *
+ * @return 1 if a thread was signaled, 0 if no thread is waiting.
+ *
+ */
+static uint32_t signalWaitingThread(RTOS_condvar_t * pCondvar)
+{
+	RTOS_thread_t * pThread;
+	RTOS_mutex_t * pMutex;
+	uint32_t signaled = 0;
+
+	if(pCondvar->waitingList.numOfItems > 0)
+	{
+		pThread = pCondvar->waitingList.listEnd.pNext->pThread;
+		ASSERT(pThread != NULL);
+		pMutex = pThread->pCondvarMutex;
+
+		RTOS_HOOK_THREAD_WOKEN(pThread, &pCondvar->waitingList);
+		RTOS_listRemove(&pThread->eventListItem);
+		if(pThread->listItem.pList != NULL)
+		{
+			/* Signaled before the wait time expired */
+			RTOS_listRemove(&pThread->listItem);
+		}
+		pThread->condvarState = CONDVAR_SIGNALED;
+
+		if(pMutex->mutexValue == 0)
+		{
+			/* Wait morphing, wait for the mutex without waking up */
+			RTOS_TRACE(TRACE_EVENT_THREAD_BLOCK, &pMutex->waitingList);
+			RTOS_HOOK_THREAD_BLOCKED(pThread, &pMutex->waitingList);
+			RTOS_listInsert(&pMutex->waitingList, &pThread->eventListItem);
+		}else
+		{
+			RTOS_threadAddToReadyList(pThread);
+		}
+		signaled = 1;
+	}else
+	{
+		/* No threads are waiting, do nothing */
+	}
+
+	return signaled;
+}
+
+/**
+ * @brief Initializes a condition variable.
+ *
+ * @param[out] pCondvar Pointer to the condition variable. Must not be NULL.
+ *
+ */
+void RTOS_condvarCreate(RTOS_condvar_t * pCondvar)
+{
+	ASSERT(pCondvar != NULL);
+	RTOS_listInit(&pCondvar->waitingList);
+}
+
+/**
+ * @brief Releases a mutex and waits on a condition variable, then locks the mutex again.
+ *
+ * The first call releases the mutex and blocks the thread on the condition variable
+ * atomically. The call is repeated when the thread wakes up, it then locks the mutex
+ * again, waiting for it if needed, before returning.
+ *
+ * @param[in,out] pCondvar Pointer to the condition variable. Must not be NULL.
+ * @param[in]     waitTime Wait time in ticks or WAIT_INDEFINITELY, must not be NO_WAIT.
+ * @param[in,out] pMutex   Pointer to the mutex locked once by the running thread.
+ *
+ * @return RTOS_SUCCESS if signaled, RTOS_FAILURE if the wait time expired,
+ * RTOS_MUTEX_OWNER_DIED if the mutex was handed over from a destroyed owner,
+ * RTOS_CONTEXT_SWITCH_TRIGGERED if the thread is blocked. The mutex is locked
+ * again in all cases except the last one.
+ *
+ */
+uint32_t RTOS_condvarWait(RTOS_condvar_t * pCondvar, int32_t waitTime, RTOS_mutex_t * pMutex)
+{
+	ASSERT(pCondvar != NULL);
+	ASSERT(pMutex != NULL);
+
+	RTOS_thread_t * pRunningThread = RTOS_threadGetRunning();
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+	RTOS_return_t lockStatus;
+
+	if(pRunningThread->condvarState == CONDVAR_NOT_WAITING)
+	{
+		ASSERT(waitTime != NO_WAIT);
+		ASSERT(waitTime >= WAIT_INDEFINITELY);
+		ASSERT(pMutex->pOwner == pRunningThread);
+		ASSERT(pMutex->lockCount == 1);
+
+		/* Release the mutex and wait for a signal */
+		pRunningThread->pCondvarMutex = pMutex;
+		pRunningThread->condvarState = CONDVAR_WAITING;
+		RTOS_mutexRelease(pMutex);
+		RTOS_threadBlockRunning(&pCondvar->waitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		if(pRunningThread->condvarState == CONDVAR_WAITING)
+		{
+			/* Woken up without a signal */
+			pRunningThread->condvarState = CONDVAR_TIMED_OUT;
+		}
+
+		/* Lock the mutex again */
+		lockStatus = RTOS_mutexLock(pMutex, WAIT_INDEFINITELY);
+		if(lockStatus == RTOS_CONTEXT_SWITCH_TRIGGERED)
+		{
+			returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+		}else
+		{
+			if(lockStatus == RTOS_MUTEX_OWNER_DIED)
+			{
+				returnStatus = RTOS_MUTEX_OWNER_DIED;
+			}else if(pRunningThread->condvarState == CONDVAR_SIGNALED)
+			{
+				returnStatus = RTOS_SUCCESS;
+			}else
+			{
+				returnStatus = RTOS_FAILURE;
+			}
+			pRunningThread->condvarState = CONDVAR_NOT_WAITING;
+			pRunningThread->pCondvarMutex = NULL;
+		}
+	}
+
+	return returnStatus;
+}
+
+/**
+ * @brief Signals the highest priority thread waiting on a condition variable.
+ *
+ * @param[in,out] pCondvar Pointer to the condition variable. Must not be NULL.
+ *
+ */
+void RTOS_condvarSignal(RTOS_condvar_t * pCondvar)
+{
+	ASSERT(pCondvar != NULL);
+	signalWaitingThread(pCondvar);
+}
+
+/**
+ * @brief Signals all threads waiting on a condition variable.
+ *
+ * @param[in,out] pCondvar Pointer to the condition variable. Must not be NULL.
+ *
+ */
+void RTOS_condvarBroadcast(RTOS_condvar_t * pCondvar)
+{
+	ASSERT(pCondvar != NULL);
+	while(signalWaitingThread(pCondvar) == 1)
+	{
+
+	}
+}
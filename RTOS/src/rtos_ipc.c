@@ -0,0 +1,238 @@
+/*
+ * rtos_ipc.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+static void deliverCall(RTOS_thread_t * pServer, RTOS_thread_t * pClient);
+
+/**
+ * @brief Passes the call message of a client to a server waiting in reply wait.
+ *
+ * The message words are copied from the SVC frame of the client to the SVC frame
+ * of the server, and the client priority is donated to the server until it replies.
+ *
+ * @param[in,out] pServer Pointer to the server, its SVC frame must be saved.
+ * @param[in,out] pClient Pointer to the client, its SVC frame must be saved.
+ *
+ */
+static void deliverCall(RTOS_thread_t * pServer, RTOS_thread_t * pClient)
+{
+	uint32_t * pServerFrame = pServer->pIpcFrame;
+
+	/* Message is in r1 to r3 of the frames */
+	pServerFrame[0] = RTOS_SUCCESS;
+	memcpy(&pServerFrame[1], &pClient->pIpcFrame[1], IPC_MESSAGE_WORDS * sizeof(uint32_t));
+	pServer->pIpcFrame = NULL;
+
+	pServer->pIpcClient = pClient;
+	pClient->pIpcServer = pServer;
+
+	if(pClient->priority < pServer->priority)
+	{
+		RTOS_threadSetPriority(pServer, pClient->priority);
+	}
+}
+
+/**
+ * @brief Initializes an IPC endpoint.
+ *
+ * One server thread serves an endpoint with RTOS_SVC_replyWait, client threads
+ * call it with RTOS_SVC_call.
+ *
+ * @param[out] pEndpoint Pointer to the endpoint. Must not be NULL.
+ *
+ */
+void RTOS_endpointCreate(RTOS_endpoint_t * pEndpoint)
+{
+	ASSERT(pEndpoint != NULL);
+
+	pEndpoint->pOwner = NULL;
+	pEndpoint->pServer = NULL;
+	RTOS_listInit(&pEndpoint->callersList);
+}
+
+/**
+ * @brief Calls the server of an endpoint and waits for its reply.
+ *
+ * The message is passed in r1 to r3 of the SVC frame. If the server is waiting,
+ * it gets the message and the CPU directly, without searching the ready lists.
+ * Otherwise the client waits in priority order until the server replies to the
+ * previous calls, and the client priority is donated to the busy server. The
+ * reply is written into r0 to r3 of the client SVC frame, so the call is not
+ * retried when the client wakes up.
+ *
+ * @param[in,out] pEndpoint Pointer to the endpoint. Must not be NULL.
+ * @param[in,out] pFrame    Pointer to the SVC frame of the client.
+ *
+ */
+void RTOS_ipcCall(RTOS_endpoint_t * pEndpoint, uint32_t * pFrame)
+{
+	ASSERT(pEndpoint != NULL);
+	ASSERT(pFrame != NULL);
+
+	RTOS_thread_t * pClient = RTOS_threadGetRunning();
+	RTOS_thread_t * pServer = pEndpoint->pServer;
+
+	ASSERT(pEndpoint->pOwner != pClient);
+
+	pClient->pIpcFrame = pFrame;
+
+	if(pServer != NULL)
+	{
+		/* Server is waiting, switch directly to it */
+		pEndpoint->pServer = NULL;
+		RTOS_TRACE(TRACE_EVENT_THREAD_BLOCK, &pEndpoint->callersList);
+		RTOS_HOOK_THREAD_BLOCKED(pClient, &pEndpoint->callersList);
+		RTOS_HOOK_THREAD_WOKEN(pServer, &pEndpoint->callersList);
+		RTOS_listRemove(&pClient->listItem);
+		deliverCall(pServer, pClient);
+		RTOS_threadAddToReadyList(pServer);
+		RTOS_threadHandoff(pServer);
+		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	}else
+	{
+		if((pEndpoint->pOwner != NULL) && (pClient->priority < pEndpoint->pOwner->priority))
+		{
+			/* Busy server runs at the priority of its highest client */
+			RTOS_threadSetPriority(pEndpoint->pOwner, pClient->priority);
+		}
+		RTOS_threadBlockRunning(&pEndpoint->callersList, WAIT_INDEFINITELY);
+	}
+}
+
+/**
+ * @brief Replies to the current client of a server and waits for the next call.
+ *
+ * The reply is passed in r1 to r3 of the SVC frame, the first call of a server has
+ * no client to reply to. The server priority is restored to its priority at its first
+ * reply wait. If a client is waiting, its message is returned immediately. Otherwise
+ * the server waits for the next call and the replied client gets the CPU directly.
+ *
+ * @param[in,out] pEndpoint Pointer to the endpoint. Must not be NULL.
+ * @param[in,out] pFrame    Pointer to the SVC frame of the server.
+ *
+ */
+void RTOS_ipcReplyWait(RTOS_endpoint_t * pEndpoint, uint32_t * pFrame)
+{
+	ASSERT(pEndpoint != NULL);
+	ASSERT(pFrame != NULL);
+
+	RTOS_thread_t * pServer = RTOS_threadGetRunning();
+	RTOS_thread_t * pClient = pServer->pIpcClient;
+
+	ASSERT((pEndpoint->pOwner == NULL) || (pEndpoint->pOwner == pServer));
+
+	if(pEndpoint->pOwner == NULL)
+	{
+		/* First reply wait binds the server to the endpoint */
+		pEndpoint->pOwner = pServer;
+		pServer->pIpcEndpoint = pEndpoint;
+		pServer->ipcBasePriority = pServer->priority;
+	}
+
+	pServer->pIpcFrame = pFrame;
+
+	if(pClient != NULL)
+	{
+		/* Write the reply into the client frame */
+		pClient->pIpcFrame[0] = RTOS_SUCCESS;
+		memcpy(&pClient->pIpcFrame[1], &pFrame[1], IPC_MESSAGE_WORDS * sizeof(uint32_t));
+		pClient->pIpcFrame = NULL;
+		pClient->pIpcServer = NULL;
+		pServer->pIpcClient = NULL;
+
+		/* End the priority donation */
+		if(pServer->priority != pServer->ipcBasePriority)
+		{
+			RTOS_threadSetPriority(pServer, pServer->ipcBasePriority);
+		}
+		RTOS_HOOK_THREAD_WOKEN(pClient, &pEndpoint->callersList);
+		RTOS_threadAddToReadyList(pClient);
+	}
+
+	if(pEndpoint->callersList.numOfItems > 0)
+	{
+		/* Serve the highest priority waiting client */
+		pClient = pEndpoint->callersList.listEnd.pNext->pThread;
+		ASSERT(pClient != NULL);
+		/* Client leaves the callers list, it stays blocked until the reply */
+		RTOS_listRemove(&pClient->eventListItem);
+		deliverCall(pServer, pClient);
+	}else
+	{
+		pEndpoint->pServer = pServer;
+		RTOS_TRACE(TRACE_EVENT_THREAD_BLOCK, &pEndpoint->callersList);
+		RTOS_HOOK_THREAD_BLOCKED(pServer, &pEndpoint->callersList);
+		RTOS_listRemove(&pServer->listItem);
+		if(pClient != NULL)
+		{
+			RTOS_threadHandoff(pClient);
+		}
+		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	}
+}
+
+/**
+ * @brief Ends the IPC of a destroyed thread.
+ *
+ * A destroyed server releases its endpoint, its current client and the clients
+ * waiting on the endpoint wake up with RTOS_FAILURE. A client destroyed during a
+ * call ends the priority donation to its server, the reply is then dropped. A
+ * server calling another server while serving is handled as both.
+ *
+ * @param[in,out] pThread Pointer to the destroyed thread. Must not be NULL.
+ *
+ */
+void RTOS_ipcReleaseThread(RTOS_thread_t * pThread)
+{
+	ASSERT(pThread != NULL);
+
+	RTOS_thread_t * pClient = pThread->pIpcClient;
+	RTOS_thread_t * pServer = pThread->pIpcServer;
+	RTOS_endpoint_t * pEndpoint = pThread->pIpcEndpoint;
+
+	if(pEndpoint != NULL)
+	{
+		/* Another thread can serve the endpoint */
+		pEndpoint->pOwner = NULL;
+		pEndpoint->pServer = NULL;
+		pThread->pIpcEndpoint = NULL;
+
+		/* Queued calls fail instead of waiting for a server forever */
+		while(pEndpoint->callersList.numOfItems > 0)
+		{
+			pClient = RTOS_threadWakeUpWaiting(&pEndpoint->callersList);
+			pClient->pIpcFrame[0] = RTOS_FAILURE;
+			pClient->pIpcFrame = NULL;
+		}
+		pClient = pThread->pIpcClient;
+	}
+
+	if(pClient != NULL)
+	{
+		/* Server destroyed while serving, the client call fails */
+		pThread->pIpcClient = NULL;
+		pClient->pIpcServer = NULL;
+		pClient->pIpcFrame[0] = RTOS_FAILURE;
+		pClient->pIpcFrame = NULL;
+		RTOS_HOOK_THREAD_WOKEN(pClient, (pEndpoint != NULL) ? &pEndpoint->callersList : NULL);
+		RTOS_threadAddToReadyList(pClient);
+	}
+
+	if(pServer != NULL)
+	{
+		/* Client destroyed while waiting for the reply */
+		pThread->pIpcServer = NULL;
+		pServer->pIpcClient = NULL;
+		if(pServer->priority != pServer->ipcBasePriority)
+		{
+			RTOS_threadSetPriority(pServer, pServer->ipcBasePriority);
+		}
+	}
+
+	pThread->pIpcFrame = NULL;
+}
@@ -22,6 +22,7 @@ void RTOS_listInit(RTOS_list_t * pList)
 	pList->listEnd.pNext = (RTOS_listItem_t *) &pList->listEnd;
 	pList->listEnd.pPrev = (RTOS_listItem_t *) &pList->listEnd;
 	pList->numOfItems = 0;
+	pList->maxNumOfItems = 0;
 }
 
 /**
@@ -100,6 +101,28 @@ void RTOS_listInsert(RTOS_list_t * pList, RTOS_listItem_t * pItem)
 
 	pItem->pList = (void *) pList;
 	pList->numOfItems++;
+
+#if (KERNEL_STATS_ENABLE == 1)
+	if(pList->numOfItems > pList->maxNumOfItems)
+	{
+		pList->maxNumOfItems = pList->numOfItems;
+	}
+#endif
 }
 
+/**
+ * @brief Gets the most items the list held.
+ *
+ * Only counted by RTOS_listInsert with KERNEL_STATS_ENABLE set, so it covers the
+ * timer list and the waiting lists of the kernel objects, not the ready lists.
+ *
+ * @param pList Pointer to the RTOS_list_t structure.
+ *
+ * @return High water mark of the list, or 0 if kernel statistics are not enabled.
+ */
+uint32_t RTOS_listGetHighWater(const RTOS_list_t * pList)
+{
+	ASSERT(pList != NULL);
 
+	return pList->maxNumOfItems;
+}
@@ -0,0 +1,73 @@
+/*
+ * rtos_log.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+#if (LOG_ENABLE == 1)
+
+RTOS_logBuffer_t RTOS_logBuffer;
+
+/**
+ * @brief Initializes the log buffer.
+ *
+ * The buffer is drained on the target by RTOS_logGet, or found in a RAM dump
+ * by its magic word and decoded on the host by tools/log_decode.py. Without a
+ * consumer thread, set LOG_OVERWRITE so the dump holds the latest records.
+ *
+ */
+void RTOS_logInit(void)
+{
+	/* Ring index is masked, size must be a power of two */
+	ASSERT((LOG_BUFFER_RECORDS & (LOG_BUFFER_RECORDS - 1)) == 0);
+
+	memset(&RTOS_logBuffer, 0, sizeof(RTOS_logBuffer));
+	RTOS_logBuffer.tickRateHz = SYS_TICK_RATE_HZ;
+	RTOS_logBuffer.recordsNum = LOG_BUFFER_RECORDS;
+	RTOS_logBuffer.magic = LOG_MAGIC;
+}
+
+#if (LOG_OVERWRITE == 0)
+/**
+ * @brief Takes the oldest log record out of the ring.
+ *
+ * Meant for a single low priority consumer thread, which formats the record
+ * off the hot path, e.g.
+ * printf(record.pFormat, record.args[0], record.args[1], record.args[2], record.args[3]);
+ * Needs no SVC, the ring is only accessed through memory.
+ *
+ * @param[out] pRecord Pointer to the copy of the record. Must not be NULL.
+ *
+ * @return 1 if a record is copied, 0 if the ring is empty or the oldest record
+ * is still being written.
+ */
+uint32_t RTOS_logGet(RTOS_logRecord_t * pRecord)
+{
+	RTOS_logRecord_t * pSlot;
+	uint32_t readCount = RTOS_logBuffer.readCount;
+
+	ASSERT(pRecord != NULL);
+
+	pSlot = &RTOS_logBuffer.records[readCount & (LOG_BUFFER_RECORDS - 1)];
+	if(pSlot->sequence != (readCount + 1))
+	{
+		return 0;
+	}
+
+	/* Read the record only after its commit */
+	__DMB();
+	memcpy(pRecord, pSlot, sizeof(*pRecord));
+
+	/* Free the slot only after the copy */
+	__DMB();
+	RTOS_logBuffer.readCount = readCount + 1;
+
+	return 1;
+}
+
+#endif
+
+#endif
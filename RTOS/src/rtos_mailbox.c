@@ -30,6 +30,7 @@ static void checkWaitingThreads(RTOS_mailbox_t * pMailbox)
 	{
 		pThread = pMailbox->waitingList.listEnd.pNext->pThread;
 		ASSERT(NULL != pThread);
+		RTOS_HOOK_THREAD_WOKEN(pThread, &pMailbox->waitingList);
 		RTOS_listRemove(&pThread->eventListItem);
 		if(pThread->listItem.pList != NULL)
 		{
@@ -60,8 +61,11 @@ static void blockCurrentThread(RTOS_mailbox_t * pMailbox)
 {
 	RTOS_thread_t * pRunningThread;
 	pRunningThread = RTOS_threadGetRunning();
+	RTOS_TRACE(TRACE_EVENT_THREAD_BLOCK, &pMailbox->waitingList);
+	RTOS_HOOK_THREAD_BLOCKED(pRunningThread, &pMailbox->waitingList);
 	RTOS_listRemove(&pRunningThread->listItem);
 	RTOS_listInsert(&pMailbox->waitingList, &pRunningThread->eventListItem);
+	KERNEL_STATS_MAX(waitingListHighWater, pMailbox->waitingList.numOfItems);
 	SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 }
 
@@ -75,7 +79,7 @@ static void blockCurrentThread(RTOS_mailbox_t * pMailbox)
  *
  * @param[out] pMailbox     Pointer to the mailbox object to be initialized. Must not be NULL.
  * @param[in]  pBuffer      Pointer to the memory buffer used for storing messages. Must not be NULL.
- * @param[in]  bufferLength Length of the buffer in bytes. Must be non-zero.
+ * @param[in]  bufferLength Length of the buffer in bytes. Must hold at least one message.
  * @param[in]  messageSize  Size of each message in bytes. Must be 1, 2, or 4.
  *
  */
@@ -84,12 +88,12 @@ void RTOS_mailboxCreate(RTOS_mailbox_t * pMailbox, void * pBuffer, uint32_t buff
 	/* Check input parameters */
 	ASSERT(pMailbox != NULL);
 	ASSERT(pBuffer != NULL);
-	ASSERT(bufferLength != 0);
 	ASSERT((messageSize == 1) || (messageSize == 2) || (messageSize == 4));
+	ASSERT(bufferLength >= messageSize);
 
-	/* Set mailbox buffer start and end */
+	/* Set mailbox buffer start and end, the end is aligned to the message size */
 	pMailbox->pStart = (int8_t *) pBuffer;
-	pMailbox->pEnd = pMailbox->pStart + messageSize;
+	pMailbox->pEnd = pMailbox->pStart + (bufferLength - (bufferLength % messageSize));
 
 	/* Initialize read and write indices */
 	pMailbox->pReadIndex = pMailbox->pStart;
@@ -99,7 +103,8 @@ void RTOS_mailboxCreate(RTOS_mailbox_t * pMailbox, void * pBuffer, uint32_t buff
 	pMailbox->messageSize = messageSize;
 	pMailbox->bufferLength = bufferLength;
 
-	pMailbox->messageSize = 0;
+	pMailbox->messagesNum = 0;
+	pMailbox->pQueueSet = NULL;
 	RTOS_listInit(&pMailbox->waitingList);
 }
 
@@ -134,8 +139,10 @@ uint32_t RTOS_mailboxWrite(RTOS_mailbox_t * pMailbox, int32_t waitTime, const vo
 
 	RTOS_return_t returnStatus = RTOS_FAILURE;
 
+	RTOS_TRACE(TRACE_EVENT_MAILBOX_WRITE, pMailbox);
+
 	/* Check if there is a free place to write */
-	if(pMailbox->bufferLength > pMailbox->messagesNum)
+	if((pMailbox->bufferLength / pMailbox->messageSize) > pMailbox->messagesNum)
 	{
 		/* Buffer is not full, copy data */
 		memcpy((void *) pMailbox->pWriteIndex, pMessage, pMailbox->messageSize);
@@ -152,6 +159,10 @@ uint32_t RTOS_mailboxWrite(RTOS_mailbox_t * pMailbox, int32_t waitTime, const vo
 		}
 		pMailbox->messagesNum++;
 		checkWaitingThreads(pMailbox);
+		if(pMailbox->pQueueSet != NULL)
+		{
+			RTOS_queueSetNotify(pMailbox->pQueueSet);
+		}
 		returnStatus = RTOS_SUCCESS;
 	}
 	else
@@ -206,9 +217,11 @@ uint32_t RTOS_mailboxRead(RTOS_mailbox_t * pMailbox, int32_t waitTime, void * co
 
 	RTOS_return_t returnStatus = RTOS_FAILURE;
 
+	RTOS_TRACE(TRACE_EVENT_MAILBOX_READ, pMailbox);
+
 	if(pMailbox->messagesNum > 0)
 	{
-		memcpy((void *) pMailbox->pReadIndex, pMessage, pMailbox->messageSize);
+		memcpy(pMessage, (const void *) pMailbox->pReadIndex, pMailbox->messageSize);
 		pMailbox->pReadIndex += pMailbox->messageSize;
 		/* Check if the buffer is read until the end */
 		if(pMailbox->pReadIndex >= pMailbox->pEnd)
@@ -0,0 +1,296 @@
+/*
+ * rtos_msgqueue.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+/**
+ * @brief Pointer to the next slot index stored at the start of a slot
+ */
+#define SLOT_NEXT(pQueue, slot)		(*((uint32_t *) &(pQueue)->pBuffer[(slot) * (pQueue)->slotSize]))
+
+/**
+ * @brief Pointer to the message stored in a slot
+ */
+#define SLOT_MESSAGE(pQueue, slot)	(&(pQueue)->pBuffer[((slot) * (pQueue)->slotSize) + sizeof(uint32_t)])
+
+static uint32_t putMessage(RTOS_msgQueue_t * pQueue, const void * pMessage,
+		uint32_t priority, uint32_t toFront);
+static uint32_t send(RTOS_msgQueue_t * pQueue, int32_t waitTime, const void * pMessage,
+		uint32_t priority, uint32_t toFront);
+
+/**
+ * @brief Stores a message in a free slot and links it into the chain of its priority.
+ *
+ * @param[in,out] pQueue   Pointer to the message queue.
+ * @param[in]     pMessage Pointer to the message.
+ * @param[in]     priority Message priority, 0 is the most urgent.
+ * @param[in]     toFront  1 to put the message before the other messages of its priority.
+ *
+ * @return 1 if the message is stored, 0 if the queue is full.
+ *
+ */
+static uint32_t putMessage(RTOS_msgQueue_t * pQueue, const void * pMessage,
+		uint32_t priority, uint32_t toFront)
+{
+	uint32_t slot = pQueue->freeSlot;
+	uint32_t stored = 0;
+
+	if(slot != MSG_QUEUE_NO_SLOT)
+	{
+		pQueue->freeSlot = SLOT_NEXT(pQueue, slot);
+		memcpy(SLOT_MESSAGE(pQueue, slot), pMessage, pQueue->messageSize);
+
+		if(pQueue->head[priority] == MSG_QUEUE_NO_SLOT)
+		{
+			/* First message of this priority */
+			SLOT_NEXT(pQueue, slot) = MSG_QUEUE_NO_SLOT;
+			pQueue->head[priority] = slot;
+			pQueue->tail[priority] = slot;
+			pQueue->readyLevels |= (1UL << priority);
+		}else if(toFront == 1)
+		{
+			SLOT_NEXT(pQueue, slot) = pQueue->head[priority];
+			pQueue->head[priority] = slot;
+		}else
+		{
+			SLOT_NEXT(pQueue, slot) = MSG_QUEUE_NO_SLOT;
+			SLOT_NEXT(pQueue, pQueue->tail[priority]) = slot;
+			pQueue->tail[priority] = slot;
+		}
+
+		pQueue->messagesNum++;
+		RTOS_threadWakeUpWaiting(&pQueue->receiversWaitingList);
+		stored = 1;
+	}else
+	{
+		/* Queue is full */
+	}
+
+	return stored;
+}
+
+/**
+ * @brief Sends a message to the back or the front of its priority, with optional blocking.
+ *
+ * @param[in,out] pQueue   Pointer to the message queue.
+ * @param[in]     waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ * @param[in]     pMessage Pointer to the message.
+ * @param[in]     priority Message priority, 0 is the most urgent.
+ * @param[in]     toFront  1 to put the message before the other messages of its priority.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+static uint32_t send(RTOS_msgQueue_t * pQueue, int32_t waitTime, const void * pMessage,
+		uint32_t priority, uint32_t toFront)
+{
+	ASSERT(pQueue != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+	ASSERT(pMessage != NULL);
+	ASSERT(MSG_QUEUE_PRIORITY_LEVELS > priority);
+
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+
+	if(putMessage(pQueue, pMessage, priority, toFront) == 1)
+	{
+		returnStatus = RTOS_SUCCESS;
+	}else if(waitTime != NO_WAIT)
+	{
+		RTOS_threadBlockRunning(&pQueue->sendersWaitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No blocking required, do nothing */
+	}
+
+	return returnStatus;
+}
+
+/**
+ * @brief Initializes a priority message queue.
+ *
+ * Each message carries a priority from 0, the most urgent, to MSG_QUEUE_PRIORITY_LEVELS - 1.
+ * Messages are received in priority order and in FIFO order within a priority. The buffer
+ * is split into slots of MSG_QUEUE_SLOT_SIZE(messageSize) bytes, one per message.
+ *
+ * @param[out] pQueue       Pointer to the message queue. Must not be NULL.
+ * @param[in]  pBuffer      Pointer to the word aligned memory of the slots. Must not be NULL.
+ * @param[in]  bufferLength Length of the buffer in bytes, must hold at least one slot.
+ * @param[in]  messageSize  Size of each message in bytes. Must be non-zero.
+ *
+ */
+void RTOS_msgQueueCreate(RTOS_msgQueue_t * pQueue, void * pBuffer,
+		uint32_t bufferLength, uint32_t messageSize)
+{
+	ASSERT(pQueue != NULL);
+	ASSERT(pBuffer != NULL);
+	ASSERT(((uint32_t) pBuffer & 3u) == 0);
+	ASSERT(messageSize != 0);
+	ASSERT(bufferLength >= MSG_QUEUE_SLOT_SIZE(messageSize));
+
+	uint32_t slot;
+
+	pQueue->pBuffer = (uint8_t *) pBuffer;
+	pQueue->messageSize = messageSize;
+	pQueue->slotSize = MSG_QUEUE_SLOT_SIZE(messageSize);
+	pQueue->slotsNum = bufferLength / pQueue->slotSize;
+	pQueue->messagesNum = 0;
+	pQueue->readyLevels = 0;
+
+	/* Chain all slots into the free chain */
+	for(slot = 0; slot < pQueue->slotsNum; slot++)
+	{
+		SLOT_NEXT(pQueue, slot) = slot + 1;
+	}
+	SLOT_NEXT(pQueue, pQueue->slotsNum - 1) = MSG_QUEUE_NO_SLOT;
+	pQueue->freeSlot = 0;
+
+	for(uint32_t priority = 0; priority < MSG_QUEUE_PRIORITY_LEVELS; priority++)
+	{
+		pQueue->head[priority] = MSG_QUEUE_NO_SLOT;
+		pQueue->tail[priority] = MSG_QUEUE_NO_SLOT;
+	}
+
+	RTOS_listInit(&pQueue->sendersWaitingList);
+	RTOS_listInit(&pQueue->receiversWaitingList);
+}
+
+/**
+ * @brief Sends a message behind the messages of the same priority, with optional
+ * blocking if the queue is full.
+ *
+ * If the queue is full, the behavior depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is blocked until a slot is free.
+ * - If `waitTime` is NO_WAIT, the function returns immediately without sending the message.
+ *
+ * @param[in,out] pQueue   Pointer to the message queue. Must not be NULL.
+ * @param[in]     waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ * @param[in]     pMessage Pointer to the message. Must not be NULL.
+ * @param[in]     priority Message priority, must be less than MSG_QUEUE_PRIORITY_LEVELS.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+uint32_t RTOS_msgQueueSend(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		const void * pMessage, uint32_t priority)
+{
+	return send(pQueue, waitTime, pMessage, priority, 0);
+}
+
+/**
+ * @brief Sends a message ahead of the messages of the same priority, with optional
+ * blocking if the queue is full.
+ *
+ * Used for urgent messages, e.g. an emergency stop sent with priority 0 is received
+ * next regardless of the queue depth.
+ *
+ * @param[in,out] pQueue   Pointer to the message queue. Must not be NULL.
+ * @param[in]     waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ * @param[in]     pMessage Pointer to the message. Must not be NULL.
+ * @param[in]     priority Message priority, must be less than MSG_QUEUE_PRIORITY_LEVELS.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+uint32_t RTOS_msgQueueSendToFront(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		const void * pMessage, uint32_t priority)
+{
+	return send(pQueue, waitTime, pMessage, priority, 1);
+}
+
+/**
+ * @brief Sends a message from an interrupt handler without blocking.
+ *
+ * Interrupts are disabled while the queue and the thread lists are updated.
+ *
+ * @param[in,out] pQueue   Pointer to the message queue. Must not be NULL.
+ * @param[in]     pMessage Pointer to the message. Must not be NULL.
+ * @param[in]     priority Message priority, must be less than MSG_QUEUE_PRIORITY_LEVELS.
+ *
+ * @return RTOS_SUCCESS, or RTOS_FAILURE if the queue is full.
+ *
+ */
+uint32_t RTOS_msgQueueSendFromISR(RTOS_msgQueue_t * pQueue, const void * pMessage,
+		uint32_t priority)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint32_t returnStatus;
+
+	__disable_irq();
+	KERNEL_STATS_SECTION_START(entryCycle);
+	returnStatus = send(pQueue, NO_WAIT, pMessage, priority, 0);
+	KERNEL_STATS_SECTION_END(entryCycle);
+	__set_PRIMASK(primask);
+
+	return returnStatus;
+}
+
+/**
+ * @brief Receives the most urgent message, with optional blocking if the queue is empty.
+ *
+ * The most urgent non-empty priority is found in constant time from the bitmap of
+ * non-empty priorities. If the queue is empty, the behavior depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is blocked until a message is sent.
+ * - If `waitTime` is NO_WAIT, the function returns immediately without a message.
+ *
+ * @param[in,out] pQueue    Pointer to the message queue. Must not be NULL.
+ * @param[in]     waitTime  Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ * @param[out]    pMessage  Pointer to the destination of the message. Must not be NULL.
+ * @param[out]    pPriority Set to the message priority, can be NULL.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+uint32_t RTOS_msgQueueReceive(RTOS_msgQueue_t * pQueue, int32_t waitTime,
+		void * pMessage, uint32_t * pPriority)
+{
+	ASSERT(pQueue != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+	ASSERT(pMessage != NULL);
+
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+	uint32_t priority;
+	uint32_t slot;
+
+	if(pQueue->readyLevels != 0)
+	{
+		/* Lowest set bit is the most urgent priority */
+		priority = __CLZ(__RBIT(pQueue->readyLevels));
+		slot = pQueue->head[priority];
+
+		memcpy(pMessage, SLOT_MESSAGE(pQueue, slot), pQueue->messageSize);
+
+		pQueue->head[priority] = SLOT_NEXT(pQueue, slot);
+		if(pQueue->head[priority] == MSG_QUEUE_NO_SLOT)
+		{
+			pQueue->tail[priority] = MSG_QUEUE_NO_SLOT;
+			pQueue->readyLevels &= ~(1UL << priority);
+		}
+
+		/* Return the slot to the free chain */
+		SLOT_NEXT(pQueue, slot) = pQueue->freeSlot;
+		pQueue->freeSlot = slot;
+		pQueue->messagesNum--;
+
+		if(pPriority != NULL)
+		{
+			*pPriority = priority;
+		}
+
+		RTOS_threadWakeUpWaiting(&pQueue->sendersWaitingList);
+		returnStatus = RTOS_SUCCESS;
+	}else if(waitTime != NO_WAIT)
+	{
+		RTOS_threadBlockRunning(&pQueue->receiversWaitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No blocking required, do nothing */
+	}
+
+	return returnStatus;
+}
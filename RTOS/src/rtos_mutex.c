@@ -7,6 +7,53 @@
 
 #include "rtos.h"
 
+static void linkOwned(RTOS_mutex_t * pMutex, RTOS_thread_t * pThread);
+static void unlinkOwned(RTOS_mutex_t * pMutex);
+
+/**
+ * @brief Adds a mutex to the list of mutexes held by a thread.
+ *
+ * @param[in,out] pMutex  Pointer to the mutex, its owner is set to the thread.
+ * @param[in,out] pThread Pointer to the new owner.
+ *
+ */
+static void linkOwned(RTOS_mutex_t * pMutex, RTOS_thread_t * pThread)
+{
+	pMutex->pOwner = pThread;
+	pMutex->lockCount = 1;
+	pMutex->pNextOwned = pThread->pOwnedMutexes;
+	pThread->pOwnedMutexes = pMutex;
+}
+
+/**
+ * @brief Removes a mutex from the list of mutexes held by its owner.
+ *
+ * @param[in,out] pMutex Pointer to the mutex, its owner is cleared.
+ *
+ */
+static void unlinkOwned(RTOS_mutex_t * pMutex)
+{
+	RTOS_mutex_t ** ppOwned;
+
+	if(pMutex->pOwner != NULL)
+	{
+		ppOwned = &pMutex->pOwner->pOwnedMutexes;
+		while((*ppOwned != NULL) && (*ppOwned != pMutex))
+		{
+			ppOwned = &(*ppOwned)->pNextOwned;
+		}
+
+		if(*ppOwned == pMutex)
+		{
+			*ppOwned = pMutex->pNextOwned;
+		}
+	}
+
+	pMutex->pOwner = NULL;
+	pMutex->pNextOwned = NULL;
+	pMutex->lockCount = 0;
+}
+
 /**
  * @brief Initializes a mutex object for use in the RTOS.
  *
@@ -32,26 +79,51 @@ void RTOS_mutexCreate(RTOS_mutex_t * pMutex, uint32_t initialValue)
 	/* Initialize mutex value */
 	pMutex->mutexValue = initialValue;
 
+	/* Not recursive, no owner */
+	pMutex->recursive = 0;
+	pMutex->lockCount = 0;
+	pMutex->ownerDied = 0;
+	pMutex->pOwner = NULL;
+	pMutex->pNextOwned = NULL;
+}
+
+/**
+ * @brief Initializes a recursive mutex object.
+ *
+ * The owner of a recursive mutex can lock it again, it is released when
+ * the owner releases it as many times as it locked it. The mutex is created
+ * available.
+ *
+ * @param[in,out] pMutex Pointer to the mutex object to be initialized.
+ *                       Must not be NULL.
+ *
+ */
+void RTOS_mutexCreateRecursive(RTOS_mutex_t * pMutex)
+{
+	RTOS_mutexCreate(pMutex, 1);
+	pMutex->recursive = 1;
 }
 
 /**
  * @brief Attempts to lock a mutex, with optional blocking behavior.
  *
  * This function attempts to acquire a mutex lock. If the mutex is available,
- * it locks the mutex and returns immediately. If the mutex is not available,
- * the behavior depends on the `waitFlag`:
- * - If `waitFlag` is 1, the calling thread is added to the mutex's waiting list,
+ * it locks the mutex and returns immediately. The owner of a recursive mutex
+ * locks it again and increments its nesting count. If the mutex is not available,
+ * the behavior depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is added to the mutex's waiting list,
  *   and the PendSV interrupt is triggered to perform a context switch.
- * - If `waitFlag` is 0, the function returns without blocking.
+ * - If `waitTime` is NO_WAIT, the function returns without blocking.
  *
  * @param[in,out] pMutex   Pointer to the mutex object to be locked. Must not be NULL.
- * @param[in]     waitFlag Determines blocking behavior:
- *                         0 - Do not block if the mutex is locked.
- *                         1 - Block and wait for the mutex to become available.
+ * @param[in]     waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
  *
  * @return Status of the lock operation:
- *         1 - Mutex successfully locked.
- *         2 - Mutex not locked, thread added to the waiting list (only if `waitFlag` is 1).
+ *         RTOS_SUCCESS - Mutex successfully locked.
+ *         RTOS_MUTEX_OWNER_DIED - Mutex locked, its previous owner was destroyed
+ *                                 while holding it, the protected data may be inconsistent.
+ *         RTOS_FAILURE - Mutex not locked.
+ *         RTOS_CONTEXT_SWITCH_TRIGGERED - Mutex not locked, thread added to the waiting list.
  *
  */
 uint32_t RTOS_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime)
@@ -60,10 +132,31 @@ uint32_t RTOS_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime)
 	ASSERT(pMutex != NULL);
 	ASSERT(waitTime >= WAIT_INDEFINITELY);
 
-	RTOS_thread_t * pRunningThread;
+	RTOS_thread_t * pRunningThread = RTOS_threadGetRunning();
 	RTOS_return_t returnStatus = RTOS_FAILURE;
 	uint32_t terminate = 0;
 
+	RTOS_TRACE(TRACE_EVENT_MUTEX_LOCK, pMutex);
+
+	if((pMutex->pOwner == pRunningThread) && (pMutex->mutexValue == 0))
+	{
+		if(pMutex->ownerDied == 1)
+		{
+			/* Mutex was handed over when its owner was destroyed */
+			pMutex->ownerDied = 0;
+			returnStatus = RTOS_MUTEX_OWNER_DIED;
+			terminate = 1;
+		}else if(pMutex->recursive == 1)
+		{
+			pMutex->lockCount++;
+			returnStatus = RTOS_SUCCESS;
+			terminate = 1;
+		}else
+		{
+			/* Not recursive, the owner waits like any other thread */
+		}
+	}
+
 	while(terminate != 1)
 	{
 		if(__LDREXW(&pMutex->mutexValue) == 1)
@@ -72,7 +165,15 @@ uint32_t RTOS_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime)
 			if(__STREXW(0, &pMutex->mutexValue) == 0)
 			{
 				__DMB();
-				returnStatus = RTOS_SUCCESS;
+				linkOwned(pMutex, pRunningThread);
+				if(pMutex->ownerDied == 1)
+				{
+					pMutex->ownerDied = 0;
+					returnStatus = RTOS_MUTEX_OWNER_DIED;
+				}else
+				{
+					returnStatus = RTOS_SUCCESS;
+				}
 				terminate = 1;
 			}else
 			{
@@ -85,16 +186,9 @@ uint32_t RTOS_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime)
 		}
 	}
 
-	if((waitTime != NO_WAIT) && (returnStatus != RTOS_SUCCESS))
+	if((waitTime != NO_WAIT) && (returnStatus == RTOS_FAILURE))
 	{
-		pRunningThread = RTOS_threadGetRunning();
-		RTOS_listRemove(&pRunningThread->listItem);
-		RTOS_listInsert(&pMutex->waitingList, &pRunningThread->eventListItem);
-		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
-		if(waitTime > NO_WAIT)
-		{
-			RTOS_threadAddRunningToTimerList(waitTime);
-		}
+		RTOS_threadBlockRunning(&pMutex->waitingList, waitTime);
 		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
 	}
 
@@ -105,33 +199,67 @@ uint32_t RTOS_mutexLock(RTOS_mutex_t * pMutex, int32_t waitTime)
  * @brief Releases a mutex and handles any threads waiting for the mutex.
  *
  * This function unlocks a previously locked mutex, making it available for use.
+ * A recursive mutex is only unlocked by the last release of its owner.
  * If there are threads waiting for the mutex, the highest-priority thread (based
  * on the RTOS's waiting list order) is removed from the waiting list and added
  * to the ready list to resume execution.
  *
- * @param[in,out] pMutex Pointer to the mutex object to be released. Must not be NULL.
+ * @param[in,out] pMutex Pointer to the mutex object to be released. Must not be NULL,
+ *                       must be held by the running thread.
  *
  */
 void RTOS_mutexRelease(RTOS_mutex_t * pMutex)
 {
 	ASSERT(pMutex != NULL);
-	RTOS_thread_t * pThread;
-	__DMB();
-	pMutex->mutexValue = 1;
-	/* Get highest priority waiting thread, the one next from the end */
-	if(pMutex->waitingList.numOfItems > 0)
+	ASSERT(pMutex->pOwner == RTOS_threadGetRunning());
+	RTOS_TRACE(TRACE_EVENT_MUTEX_RELEASE, pMutex);
+
+	if((pMutex->recursive == 1) && (pMutex->lockCount > 1))
 	{
-		pThread = pMutex->waitingList.listEnd.pNext->pThread;
-		ASSERT(pThread != NULL);
-		RTOS_listRemove(&pThread->listItem);
-		if(pThread->listItem.pList != NULL)
-		{
-			RTOS_listRemove(&pThread->listItem);
-		}
-		RTOS_threadAddToReadyList(pThread);
+		/* Nested lock released, the owner still holds the mutex */
+		pMutex->lockCount--;
 	}else
 	{
-		/* No threads are waiting, do nothing */
+		unlinkOwned(pMutex);
+		__DMB();
+		pMutex->mutexValue = 1;
+
+		/* Wake up the highest priority waiting thread */
+		RTOS_threadWakeUpWaiting(&pMutex->waitingList);
 	}
 }
 
+/**
+ * @brief Releases all mutexes held by a destroyed thread.
+ *
+ * Each mutex is handed over to its highest priority waiting thread, which gets
+ * RTOS_MUTEX_OWNER_DIED from its lock call. A mutex without waiting threads
+ * becomes available and its next lock returns RTOS_MUTEX_OWNER_DIED.
+ *
+ * @param[in,out] pThread Pointer to the destroyed thread. Must not be NULL.
+ *
+ */
+void RTOS_mutexReleaseOwned(RTOS_thread_t * pThread)
+{
+	ASSERT(pThread != NULL);
+	RTOS_mutex_t * pMutex;
+	RTOS_thread_t * pWaitingThread;
+
+	while(pThread->pOwnedMutexes != NULL)
+	{
+		pMutex = pThread->pOwnedMutexes;
+		unlinkOwned(pMutex);
+		pMutex->ownerDied = 1;
+
+		pWaitingThread = RTOS_threadWakeUpWaiting(&pMutex->waitingList);
+		if(pWaitingThread != NULL)
+		{
+			/* Hand over, the mutex stays locked */
+			linkOwned(pMutex, pWaitingThread);
+		}else
+		{
+			__DMB();
+			pMutex->mutexValue = 1;
+		}
+	}
+}
@@ -0,0 +1,224 @@
+/*
+ * rtos_queueset.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+static struct queueSet_t ** getMemberQueueSet(void * pMember,
+		RTOS_queueSetMemberType_t memberType);
+static uint32_t isMemberReady(void * pMember, RTOS_queueSetMemberType_t memberType);
+
+/**
+ * @brief Gets the queue set field of a member object.
+ *
+ * @param[in] pMember    Pointer to the semaphore, mailbox or stream buffer.
+ * @param[in] memberType Type of the member object.
+ *
+ * @return Pointer to the queue set field of the member.
+ *
+ */
+static struct queueSet_t ** getMemberQueueSet(void * pMember,
+		RTOS_queueSetMemberType_t memberType)
+{
+	struct queueSet_t ** ppQueueSet = NULL;
+
+	switch(memberType)
+	{
+	case RTOS_QUEUE_SET_SEMAPHORE:
+		ppQueueSet = &((RTOS_semaphore_t *) pMember)->pQueueSet;
+	break;
+
+	case RTOS_QUEUE_SET_MAILBOX:
+		ppQueueSet = &((RTOS_mailbox_t *) pMember)->pQueueSet;
+	break;
+
+	case RTOS_QUEUE_SET_STREAM_BUFFER:
+		ppQueueSet = &((RTOS_streamBuffer_t *) pMember)->pQueueSet;
+	break;
+
+	default:
+		ASSERT(0);
+	break;
+	}
+
+	return ppQueueSet;
+}
+
+/**
+ * @brief Checks if a member object can be taken or read without blocking.
+ *
+ * @param[in] pMember    Pointer to the semaphore, mailbox or stream buffer.
+ * @param[in] memberType Type of the member object.
+ *
+ * @return 1 if the member is ready, 0 otherwise.
+ *
+ */
+static uint32_t isMemberReady(void * pMember, RTOS_queueSetMemberType_t memberType)
+{
+	uint32_t ready = 0;
+
+	switch(memberType)
+	{
+	case RTOS_QUEUE_SET_SEMAPHORE:
+		ready = (((RTOS_semaphore_t *) pMember)->semaphoreValue > 0);
+	break;
+
+	case RTOS_QUEUE_SET_MAILBOX:
+		ready = (((RTOS_mailbox_t *) pMember)->messagesNum > 0);
+	break;
+
+	case RTOS_QUEUE_SET_STREAM_BUFFER:
+		ready = (((RTOS_streamBuffer_t *) pMember)->usedLength
+				>= ((RTOS_streamBuffer_t *) pMember)->triggerLevel);
+	break;
+
+	default:
+		ASSERT(0);
+	break;
+	}
+
+	return ready;
+}
+
+/**
+ * @brief Initializes an empty queue set.
+ *
+ * A queue set lets one thread block on several semaphores, mailboxes and stream
+ * buffers at once, and wake up with the member that became ready.
+ *
+ * @param[out] pQueueSet Pointer to the queue set. Must not be NULL.
+ *
+ */
+void RTOS_queueSetCreate(RTOS_queueSet_t * pQueueSet)
+{
+	ASSERT(pQueueSet != NULL);
+
+	pQueueSet->membersNum = 0;
+	RTOS_listInit(&pQueueSet->waitingList);
+}
+
+/**
+ * @brief Adds an object to a queue set.
+ *
+ * An object can be a member of one queue set only. Members are checked in
+ * the order they are added.
+ *
+ * @param[in,out] pQueueSet  Pointer to the queue set. Must not be NULL.
+ * @param[in,out] pMember    Pointer to the semaphore, mailbox or stream buffer. Must not be NULL.
+ * @param[in]     memberType Type of the member object.
+ *
+ */
+void RTOS_queueSetAdd(RTOS_queueSet_t * pQueueSet, void * pMember,
+		RTOS_queueSetMemberType_t memberType)
+{
+	ASSERT(pQueueSet != NULL);
+	ASSERT(pMember != NULL);
+	ASSERT(pQueueSet->membersNum < QUEUE_SET_MAX_MEMBERS);
+
+	struct queueSet_t ** ppQueueSet = getMemberQueueSet(pMember, memberType);
+
+	ASSERT(*ppQueueSet == NULL);
+
+	pQueueSet->pMembers[pQueueSet->membersNum] = pMember;
+	pQueueSet->memberTypes[pQueueSet->membersNum] = memberType;
+	pQueueSet->membersNum++;
+	*ppQueueSet = pQueueSet;
+}
+
+/**
+ * @brief Removes an object from a queue set.
+ *
+ * @param[in,out] pQueueSet Pointer to the queue set. Must not be NULL.
+ * @param[in,out] pMember   Pointer to a member of the queue set.
+ *
+ */
+void RTOS_queueSetRemove(RTOS_queueSet_t * pQueueSet, void * pMember)
+{
+	ASSERT(pQueueSet != NULL);
+
+	uint32_t index = 0;
+
+	while((index < pQueueSet->membersNum) && (pQueueSet->pMembers[index] != pMember))
+	{
+		index++;
+	}
+
+	ASSERT(index < pQueueSet->membersNum);
+
+	*getMemberQueueSet(pMember, pQueueSet->memberTypes[index]) = NULL;
+
+	/* Keep the order of the remaining members */
+	for(pQueueSet->membersNum--; index < pQueueSet->membersNum; index++)
+	{
+		pQueueSet->pMembers[index] = pQueueSet->pMembers[index + 1];
+		pQueueSet->memberTypes[index] = pQueueSet->memberTypes[index + 1];
+	}
+}
+
+/**
+ * @brief Waits until one of the members of a queue set is ready.
+ *
+ * The members are checked in the order they are added and the first ready one is
+ * returned. The caller then takes or reads it with NO_WAIT. If no member is ready,
+ * the behavior depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is blocked until a member is
+ *   given or written.
+ * - If `waitTime` is NO_WAIT, the function returns immediately.
+ *
+ * @param[in,out] pQueueSet Pointer to the queue set. Must not be NULL.
+ * @param[in]     waitTime  Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ * @param[out]    ppMember  Set to the ready member, or NULL. Must not be NULL.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+uint32_t RTOS_queueSetSelect(RTOS_queueSet_t * pQueueSet, int32_t waitTime,
+		void ** ppMember)
+{
+	ASSERT(pQueueSet != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+	ASSERT(ppMember != NULL);
+
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+	uint32_t index;
+
+	*ppMember = NULL;
+
+	for(index = 0; index < pQueueSet->membersNum; index++)
+	{
+		if(isMemberReady(pQueueSet->pMembers[index], pQueueSet->memberTypes[index]) == 1)
+		{
+			*ppMember = pQueueSet->pMembers[index];
+			returnStatus = RTOS_SUCCESS;
+			break;
+		}
+	}
+
+	if((waitTime != NO_WAIT) && (returnStatus != RTOS_SUCCESS))
+	{
+		RTOS_threadBlockRunning(&pQueueSet->waitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No blocking required, do nothing */
+	}
+
+	return returnStatus;
+}
+
+/**
+ * @brief Wakes up a thread waiting on a queue set, called by the members
+ * when they are given or written.
+ *
+ * @param[in,out] pQueueSet Pointer to the queue set. Must not be NULL.
+ *
+ */
+void RTOS_queueSetNotify(RTOS_queueSet_t * pQueueSet)
+{
+	ASSERT(pQueueSet != NULL);
+
+	RTOS_threadWakeUpWaiting(&pQueueSet->waitingList);
+}
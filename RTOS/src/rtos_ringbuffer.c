@@ -0,0 +1,210 @@
+/*
+ * rtos_ringbuffer.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+/**
+ * @brief Initializes a single producer, single consumer ring buffer.
+ *
+ * The producer and the consumer can be threads or interrupt handlers. Only memory
+ * barriers are used, no kernel call is made except the optional notification.
+ *
+ * @param[out] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ * @param[in]  pBuffer     Pointer to the memory used for the data. Must not be NULL.
+ * @param[in]  size        Size of the memory in bytes, must be a power of two.
+ * @param[in]  pNotify     Semaphore given to the consumer when the used bytes reach
+ *                         the watermark, NULL for no notification.
+ * @param[in]  watermark   Used bytes that notify the consumer, from 1 to size.
+ *
+ */
+void RTOS_ringBufferCreate(RTOS_ringBuffer_t * pRingBuffer, void * pBuffer, uint32_t size,
+		RTOS_semaphore_t * pNotify, uint32_t watermark)
+{
+	ASSERT(pRingBuffer != NULL);
+	ASSERT(pBuffer != NULL);
+	ASSERT((size != 0) && ((size & (size - 1)) == 0));
+	ASSERT((pNotify == NULL) || ((watermark != 0) && (watermark <= size)));
+
+	pRingBuffer->pBuffer = (uint8_t *) pBuffer;
+	pRingBuffer->size = size;
+	pRingBuffer->writeCount = 0;
+	pRingBuffer->readCount = 0;
+	pRingBuffer->pNotify = pNotify;
+	pRingBuffer->watermark = watermark;
+}
+
+/**
+ * @brief Gets the contiguous free region of a ring buffer.
+ *
+ * The producer fills the region, e.g. with DMA or memcpy, then commits it.
+ *
+ * @param[in,out] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ * @param[out]    ppSpan      Set to the start of the free region.
+ *
+ * @return Length of the free region in bytes.
+ *
+ */
+uint32_t RTOS_ringBufferGetWriteSpan(RTOS_ringBuffer_t * pRingBuffer, uint8_t ** ppSpan)
+{
+	uint32_t writeIndex = pRingBuffer->writeCount & (pRingBuffer->size - 1);
+	uint32_t freeLength = pRingBuffer->size - (pRingBuffer->writeCount - pRingBuffer->readCount);
+	uint32_t spanLength = pRingBuffer->size - writeIndex;
+
+	*ppSpan = &pRingBuffer->pBuffer[writeIndex];
+
+	return (freeLength < spanLength) ? freeLength : spanLength;
+}
+
+/**
+ * @brief Makes written bytes available to the consumer.
+ *
+ * When the used bytes reach the watermark, the notification semaphore is given.
+ *
+ * @param[in,out] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ * @param[in]     length      Number of bytes written in the write span.
+ *
+ */
+void RTOS_ringBufferCommit(RTOS_ringBuffer_t * pRingBuffer, uint32_t length)
+{
+	uint32_t usedLength = pRingBuffer->writeCount - pRingBuffer->readCount;
+	ASSERT((usedLength + length) <= pRingBuffer->size);
+
+	/* Data must be written before the consumer sees the new count */
+	__DMB();
+	pRingBuffer->writeCount += length;
+
+	if((pRingBuffer->pNotify != NULL) && (usedLength < pRingBuffer->watermark)
+			&& ((usedLength + length) >= pRingBuffer->watermark))
+	{
+		if(__get_IPSR() != 0)
+		{
+			RTOS_semaphoreGiveFromISR(pRingBuffer->pNotify);
+		}else
+		{
+			RTOS_SVC_semaphoreGive(pRingBuffer->pNotify);
+		}
+	}
+}
+
+/**
+ * @brief Copies data into a ring buffer and commits it.
+ *
+ * @param[in,out] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ * @param[in]     pData       Pointer to the data.
+ * @param[in]     length      Length of the data in bytes.
+ *
+ * @return Number of bytes written, less than length if the ring buffer is full.
+ *
+ */
+uint32_t RTOS_ringBufferWrite(RTOS_ringBuffer_t * pRingBuffer, const void * pData, uint32_t length)
+{
+	const uint8_t * pSource = (const uint8_t *) pData;
+	uint8_t * pSpan;
+	uint32_t spanLength;
+	uint32_t writtenLength = 0;
+
+	/* Free region wraps around at most once */
+	for(uint32_t span = 0; (span < 2) && (writtenLength < length); span++)
+	{
+		spanLength = RTOS_ringBufferGetWriteSpan(pRingBuffer, &pSpan);
+		if(spanLength > (length - writtenLength))
+		{
+			spanLength = length - writtenLength;
+		}
+		memcpy(pSpan, &pSource[writtenLength], spanLength);
+		RTOS_ringBufferCommit(pRingBuffer, spanLength);
+		writtenLength += spanLength;
+	}
+
+	return writtenLength;
+}
+
+/**
+ * @brief Gets the contiguous used region of a ring buffer.
+ *
+ * The consumer drains the region, e.g. with DMA or memcpy, then consumes it.
+ *
+ * @param[in,out] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ * @param[out]    ppSpan      Set to the start of the used region.
+ *
+ * @return Length of the used region in bytes.
+ *
+ */
+uint32_t RTOS_ringBufferGetReadSpan(RTOS_ringBuffer_t * pRingBuffer, uint8_t ** ppSpan)
+{
+	uint32_t readIndex = pRingBuffer->readCount & (pRingBuffer->size - 1);
+	uint32_t usedLength = pRingBuffer->writeCount - pRingBuffer->readCount;
+	uint32_t spanLength = pRingBuffer->size - readIndex;
+
+	/* Count must be read before the data */
+	__DMB();
+	*ppSpan = &pRingBuffer->pBuffer[readIndex];
+
+	return (usedLength < spanLength) ? usedLength : spanLength;
+}
+
+/**
+ * @brief Frees read bytes for the producer.
+ *
+ * @param[in,out] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ * @param[in]     length      Number of bytes read from the read span.
+ *
+ */
+void RTOS_ringBufferConsume(RTOS_ringBuffer_t * pRingBuffer, uint32_t length)
+{
+	ASSERT(length <= (pRingBuffer->writeCount - pRingBuffer->readCount));
+
+	/* Data must be read before the producer can overwrite it */
+	__DMB();
+	pRingBuffer->readCount += length;
+}
+
+/**
+ * @brief Copies data out of a ring buffer and consumes it.
+ *
+ * @param[in,out] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ * @param[out]    pData       Pointer to the destination.
+ * @param[in]     length      Maximum length to read in bytes.
+ *
+ * @return Number of bytes read, less than length if the ring buffer is empty.
+ *
+ */
+uint32_t RTOS_ringBufferRead(RTOS_ringBuffer_t * pRingBuffer, void * pData, uint32_t length)
+{
+	uint8_t * pDestination = (uint8_t *) pData;
+	uint8_t * pSpan;
+	uint32_t spanLength;
+	uint32_t readLength = 0;
+
+	/* Used region wraps around at most once */
+	for(uint32_t span = 0; (span < 2) && (readLength < length); span++)
+	{
+		spanLength = RTOS_ringBufferGetReadSpan(pRingBuffer, &pSpan);
+		if(spanLength > (length - readLength))
+		{
+			spanLength = length - readLength;
+		}
+		memcpy(&pDestination[readLength], pSpan, spanLength);
+		RTOS_ringBufferConsume(pRingBuffer, spanLength);
+		readLength += spanLength;
+	}
+
+	return readLength;
+}
+
+/**
+ * @brief Gets the number of used bytes in a ring buffer.
+ *
+ * @param[in] pRingBuffer Pointer to the ring buffer. Must not be NULL.
+ *
+ * @return Number of bytes committed and not yet consumed.
+ *
+ */
+uint32_t RTOS_ringBufferGetUsed(const RTOS_ringBuffer_t * pRingBuffer)
+{
+	return pRingBuffer->writeCount - pRingBuffer->readCount;
+}
@@ -0,0 +1,331 @@
+/*
+ * rtos_rwlock.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+static void updateLockState(RTOS_rwlock_t * pRwlock);
+
+/**
+ * @brief Updates the waiting bits of a reader-writer lock and wakes up the
+ * threads that can take it.
+ *
+ * When the lock is free, it is handed over to the highest priority waiting writer.
+ * When no writer holds or waits for the lock, all waiting readers are woken up and
+ * retry their lock. The waiting bits are recomputed from the waiting lists, so
+ * writers that timed out stop blocking new readers.
+ *
+ * @param[in,out] pRwlock Pointer to the reader-writer lock.
+ *
+ */
+static void updateLockState(RTOS_rwlock_t * pRwlock)
+{
+	uint32_t lockState = pRwlock->lockState & (RWLOCK_READERS_MASK | RWLOCK_WRITER);
+	RTOS_thread_t * pWriter;
+
+	if((lockState == 0) && (pRwlock->writersWaitingList.numOfItems > 0))
+	{
+		/* Hand over the lock, the writer finds it locked for itself on retry */
+		pWriter = RTOS_threadWakeUpWaiting(&pRwlock->writersWaitingList);
+		pWriter->pHandoverRwlock = pRwlock;
+		pRwlock->pWriter = pWriter;
+		lockState = RWLOCK_WRITER;
+	}else if(((lockState & RWLOCK_WRITER) == 0) && (pRwlock->writersWaitingList.numOfItems == 0))
+	{
+		/* No writer, wake up all readers */
+		while(RTOS_threadWakeUpWaiting(&pRwlock->readersWaitingList) != NULL)
+		{
+
+		}
+	}else
+	{
+		/* Waiting threads keep waiting */
+	}
+
+	if(pRwlock->writersWaitingList.numOfItems > 0)
+	{
+		lockState |= RWLOCK_WRITER_WAITING;
+	}
+
+	if((pRwlock->writersWaitingList.numOfItems + pRwlock->readersWaitingList.numOfItems) > 0)
+	{
+		lockState |= RWLOCK_WAITERS;
+	}
+
+	pRwlock->lockState = lockState;
+}
+
+/**
+ * @brief Initializes a reader-writer lock.
+ *
+ * The lock is created free. Any number of readers can hold it at the same time,
+ * or a single writer. Waiting writers have preference over new readers.
+ *
+ * @param[out] pRwlock Pointer to the reader-writer lock. Must not be NULL.
+ *
+ */
+void RTOS_rwlockCreate(RTOS_rwlock_t * pRwlock)
+{
+	ASSERT(pRwlock != NULL);
+	pRwlock->lockState = 0;
+	pRwlock->pWriter = NULL;
+	RTOS_listInit(&pRwlock->readersWaitingList);
+	RTOS_listInit(&pRwlock->writersWaitingList);
+}
+
+/**
+ * @brief Attempts to take a reader-writer lock for reading, with optional blocking behavior.
+ *
+ * The lock is taken when no writer holds it or waits for it. Otherwise the behavior
+ * depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is added to the readers waiting list.
+ * - If `waitTime` is NO_WAIT, the function returns without blocking.
+ *
+ * @param[in,out] pRwlock  Pointer to the reader-writer lock. Must not be NULL.
+ * @param[in]     waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+uint32_t RTOS_rwlockReadLock(RTOS_rwlock_t * pRwlock, int32_t waitTime)
+{
+	ASSERT(pRwlock != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+
+	updateLockState(pRwlock);
+
+	if((pRwlock->lockState & (RWLOCK_WRITER | RWLOCK_WRITER_WAITING)) == 0)
+	{
+		ASSERT((pRwlock->lockState & RWLOCK_READERS_MASK) < RWLOCK_READERS_MASK);
+		pRwlock->lockState++;
+		returnStatus = RTOS_SUCCESS;
+	}else if(waitTime != NO_WAIT)
+	{
+		RTOS_threadBlockRunning(&pRwlock->readersWaitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No blocking required, do nothing */
+	}
+
+	updateLockState(pRwlock);
+
+	return returnStatus;
+}
+
+/**
+ * @brief Releases a reader-writer lock held for reading.
+ *
+ * The last reader hands the lock over to the highest priority waiting writer.
+ *
+ * @param[in,out] pRwlock Pointer to the reader-writer lock. Must not be NULL.
+ *
+ */
+void RTOS_rwlockReadUnlock(RTOS_rwlock_t * pRwlock)
+{
+	ASSERT(pRwlock != NULL);
+	ASSERT((pRwlock->lockState & RWLOCK_READERS_MASK) > 0);
+
+	__DMB();
+	pRwlock->lockState--;
+	updateLockState(pRwlock);
+}
+
+/**
+ * @brief Attempts to take a reader-writer lock for writing, with optional blocking behavior.
+ *
+ * The lock is taken when no reader or writer holds it. Otherwise the behavior
+ * depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is added to the writers waiting
+ *   list and new readers wait until it released the lock.
+ * - If `waitTime` is NO_WAIT, the function returns without blocking.
+ *
+ * @param[in,out] pRwlock  Pointer to the reader-writer lock. Must not be NULL.
+ * @param[in]     waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+uint32_t RTOS_rwlockWriteLock(RTOS_rwlock_t * pRwlock, int32_t waitTime)
+{
+	ASSERT(pRwlock != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+
+	RTOS_thread_t * pRunningThread = RTOS_threadGetRunning();
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+
+	updateLockState(pRwlock);
+
+	/* Write lock is not recursive */
+	ASSERT((pRunningThread->pHandoverRwlock == pRwlock) || ((pRwlock->lockState & RWLOCK_WRITER) == 0)
+			|| (pRwlock->pWriter != pRunningThread));
+
+	if(pRunningThread->pHandoverRwlock == pRwlock)
+	{
+		/* Lock was handed over while waiting */
+		pRunningThread->pHandoverRwlock = NULL;
+		returnStatus = RTOS_SUCCESS;
+	}else if((pRwlock->lockState & (RWLOCK_WRITER | RWLOCK_READERS_MASK)) == 0)
+	{
+		pRwlock->lockState |= RWLOCK_WRITER;
+		pRwlock->pWriter = pRunningThread;
+		returnStatus = RTOS_SUCCESS;
+	}else if(waitTime != NO_WAIT)
+	{
+		RTOS_threadBlockRunning(&pRwlock->writersWaitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No blocking required, do nothing */
+	}
+
+	updateLockState(pRwlock);
+
+	if(returnStatus == RTOS_SUCCESS)
+	{
+		__DMB();
+	}
+
+	return returnStatus;
+}
+
+/**
+ * @brief Releases a reader-writer lock held for writing.
+ *
+ * The lock is handed over to the highest priority waiting writer, or all waiting
+ * readers are woken up when no writer waits.
+ *
+ * @param[in,out] pRwlock Pointer to the reader-writer lock. Must not be NULL.
+ *
+ */
+void RTOS_rwlockWriteUnlock(RTOS_rwlock_t * pRwlock)
+{
+	ASSERT(pRwlock != NULL);
+	ASSERT((pRwlock->lockState & RWLOCK_WRITER) != 0);
+
+	__DMB();
+	pRwlock->pWriter = NULL;
+	pRwlock->lockState &= ~RWLOCK_WRITER;
+	updateLockState(pRwlock);
+}
+
+/**
+ * @brief Releases the write lock handed over to a destroyed thread.
+ *
+ * The lock is handed over to a waiting writer before it runs. A writer destroyed
+ * before its retry would keep the lock forever, it is passed on instead.
+ *
+ * @param[in,out] pThread Pointer to the destroyed thread.
+ *
+ */
+void RTOS_rwlockReleaseThread(RTOS_thread_t * pThread)
+{
+	RTOS_rwlock_t * pRwlock = pThread->pHandoverRwlock;
+
+	if(pRwlock != NULL)
+	{
+		pThread->pHandoverRwlock = NULL;
+		pRwlock->pWriter = NULL;
+		pRwlock->lockState &= ~RWLOCK_WRITER;
+		updateLockState(pRwlock);
+	}
+}
+
+/**
+ * @brief Takes a reader-writer lock for reading from a thread.
+ *
+ * When no writer holds or waits for the lock, the reader count is incremented
+ * with exclusive access instructions and no SVC call. Otherwise the SVC call
+ * RTOS_SVC_rwlockReadLock is made.
+ *
+ * @param[in,out] pRwlock  Pointer to the reader-writer lock. Must not be NULL.
+ * @param[in]     waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ *
+ * @return RTOS_SUCCESS if the lock is taken, RTOS_FAILURE otherwise.
+ *
+ */
+uint32_t RTOS_rwlockAcquireRead(RTOS_rwlock_t * pRwlock, int32_t waitTime)
+{
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+	uint32_t lockState = 0;
+	uint32_t terminate = 0;
+
+	while(terminate != 1)
+	{
+		lockState = __LDREXW(&pRwlock->lockState);
+		if(((lockState & (RWLOCK_WRITER | RWLOCK_WRITER_WAITING)) == 0)
+				&& ((lockState & RWLOCK_READERS_MASK) < RWLOCK_READERS_MASK))
+		{
+			if(__STREXW((lockState + 1), &pRwlock->lockState) == 0)
+			{
+				__DMB();
+				returnStatus = RTOS_SUCCESS;
+				terminate = 1;
+			}else
+			{
+				/* Store failed, try again */
+			}
+		}else
+		{
+			/* Writer holds or waits for the lock, the kernel decides */
+			__CLREX();
+			terminate = 1;
+		}
+	}
+
+	if(returnStatus != RTOS_SUCCESS)
+	{
+		returnStatus = RTOS_SVC_rwlockReadLock(pRwlock, waitTime);
+	}
+
+	return returnStatus;
+}
+
+/**
+ * @brief Releases a reader-writer lock held for reading from a thread.
+ *
+ * When no threads wait for the lock, the reader count is decremented with
+ * exclusive access instructions and no SVC call. Otherwise the SVC call
+ * RTOS_SVC_rwlockReadUnlock is made to wake them up.
+ *
+ * @param[in,out] pRwlock Pointer to the reader-writer lock. Must not be NULL.
+ *
+ */
+void RTOS_rwlockReleaseRead(RTOS_rwlock_t * pRwlock)
+{
+	uint32_t lockState = 0;
+	uint32_t released = 0;
+	uint32_t terminate = 0;
+
+	__DMB();
+	while(terminate != 1)
+	{
+		lockState = __LDREXW(&pRwlock->lockState);
+		if((lockState & RWLOCK_WAITERS) == 0)
+		{
+			if(__STREXW((lockState - 1), &pRwlock->lockState) == 0)
+			{
+				released = 1;
+				terminate = 1;
+			}else
+			{
+				/* Store failed, try again */
+			}
+		}else
+		{
+			/* Threads are waiting, the kernel wakes them up */
+			__CLREX();
+			terminate = 1;
+		}
+	}
+
+	if(released != 1)
+	{
+		RTOS_SVC_rwlockReadUnlock(pRwlock);
+	}
+}
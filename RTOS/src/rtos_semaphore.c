@@ -23,6 +23,7 @@ void RTOS_semaphoreCreate(RTOS_semaphore_t * pSemaphore, uint32_t initialValue)
 	ASSERT(pSemaphore != NULL);
 	RTOS_listInit(&pSemaphore->waitingList);
 	pSemaphore->semaphoreValue = initialValue;
+	pSemaphore->pQueueSet = NULL;
 }
 
 /**
@@ -55,6 +56,8 @@ uint32_t RTOS_semaphoreTake(RTOS_semaphore_t * pSemaphore, int32_t waitTime)
 	uint32_t semaphoreValueTemp = 0;
 	uint32_t terminate = 0;
 
+	RTOS_TRACE(TRACE_EVENT_SEMAPHORE_TAKE, pSemaphore);
+
 	while(terminate != 1)
 	{
 		semaphoreValueTemp = __LDREXW(&pSemaphore->semaphoreValue);
@@ -79,8 +82,11 @@ uint32_t RTOS_semaphoreTake(RTOS_semaphore_t * pSemaphore, int32_t waitTime)
 	if((waitTime != NO_WAIT) && (returnStatus != RTOS_SUCCESS))
 	{
 		pRunningThread = RTOS_threadGetRunning();
+		RTOS_TRACE(TRACE_EVENT_THREAD_BLOCK, &pSemaphore->waitingList);
+		RTOS_HOOK_THREAD_BLOCKED(pRunningThread, &pSemaphore->waitingList);
 		RTOS_listRemove(&pRunningThread->listItem);
 		RTOS_listInsert(&pSemaphore->waitingList, &pRunningThread->eventListItem);
+		KERNEL_STATS_MAX(waitingListHighWater, pSemaphore->waitingList.numOfItems);
 		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 		if(waitTime > NO_WAIT)
 		{
@@ -112,6 +118,9 @@ void RTOS_semaphoreGive(RTOS_semaphore_t * pSemaphore)
 	RTOS_thread_t * pThread;
 	uint32_t semaphoreValueTemp = 0;
 	uint32_t terminate = 0;
+
+	RTOS_TRACE(TRACE_EVENT_SEMAPHORE_GIVE, pSemaphore);
+
 	while(terminate != 1)
 	{
 		semaphoreValueTemp = __LDREXW(&pSemaphore->semaphoreValue);
@@ -131,6 +140,7 @@ void RTOS_semaphoreGive(RTOS_semaphore_t * pSemaphore)
 	{
 		pThread = pSemaphore->waitingList.listEnd.pNext->pThread;
 		ASSERT(pThread != NULL);
+		RTOS_HOOK_THREAD_WOKEN(pThread, &pSemaphore->waitingList);
 		RTOS_listRemove(&pThread->eventListItem);
 		if(pThread->listItem.pList != NULL)
 		{
@@ -142,5 +152,29 @@ void RTOS_semaphoreGive(RTOS_semaphore_t * pSemaphore)
 		/* No threads are waiting, do nothing */
 	}
 
+	if(pSemaphore->pQueueSet != NULL)
+	{
+		RTOS_queueSetNotify(pSemaphore->pQueueSet);
+	}
+
+}
+
+/**
+ * @brief Releases a semaphore from an interrupt handler.
+ *
+ * Interrupts are disabled while the semaphore and the thread lists are updated,
+ * since SysTick can preempt the interrupt handler.
+ *
+ * @param[in,out] pSemaphore Pointer to the semaphore object to be released. Must not be NULL.
+ *
+ */
+void RTOS_semaphoreGiveFromISR(RTOS_semaphore_t * pSemaphore)
+{
+	uint32_t primask = __get_PRIMASK();
 
+	__disable_irq();
+	KERNEL_STATS_SECTION_START(entryCycle);
+	RTOS_semaphoreGive(pSemaphore);
+	KERNEL_STATS_SECTION_END(entryCycle);
+	__set_PRIMASK(primask);
 }
@@ -0,0 +1,194 @@
+/*
+ * rtos_seqlock.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+static uint32_t incrementSequence(RTOS_seqlock_t * pSeqlock);
+
+/**
+ * @brief Increments the sequence of a seqlock.
+ *
+ * @param[in,out] pSeqlock Pointer to the seqlock.
+ *
+ * @return The new sequence value.
+ *
+ */
+static uint32_t incrementSequence(RTOS_seqlock_t * pSeqlock)
+{
+	uint32_t sequence = 0;
+	uint32_t terminate = 0;
+
+	while(terminate != 1)
+	{
+		sequence = __LDREXW((uint32_t *) &pSeqlock->sequence) + 1;
+		if(__STREXW(sequence, (uint32_t *) &pSeqlock->sequence) == 0)
+		{
+			terminate = 1;
+		}else
+		{
+			/* Store failed, try again */
+		}
+	}
+
+	return sequence;
+}
+
+/**
+ * @brief Initializes a seqlock.
+ *
+ * A seqlock protects data with a single writer and any number of readers. The
+ * writer never blocks, readers copy the data without any kernel call and retry
+ * when a write happened meanwhile. Readers must not preempt the writer, e.g. a
+ * reader in an interrupt handler with a thread writer would retry forever.
+ *
+ * @param[out] pSeqlock Pointer to the seqlock. Must not be NULL.
+ *
+ */
+void RTOS_seqlockCreate(RTOS_seqlock_t * pSeqlock)
+{
+	ASSERT(pSeqlock != NULL);
+	pSeqlock->sequence = 0;
+}
+
+/**
+ * @brief Starts a write of the data protected by a seqlock.
+ *
+ * The sequence becomes odd, readers retry until the write ends.
+ *
+ * @param[in,out] pSeqlock Pointer to the seqlock. Must not be NULL.
+ *
+ */
+void RTOS_seqlockWriteBegin(RTOS_seqlock_t * pSeqlock)
+{
+	ASSERT(pSeqlock != NULL);
+	uint32_t sequence = incrementSequence(pSeqlock);
+
+	/* Single writer, no other write is in progress */
+	ASSERT((sequence & 1) == 1);
+	__DMB();
+}
+
+/**
+ * @brief Ends a write of the data protected by a seqlock.
+ *
+ * The sequence becomes even again, readers get the new data.
+ *
+ * @param[in,out] pSeqlock Pointer to the seqlock. Must not be NULL.
+ *
+ */
+void RTOS_seqlockWriteEnd(RTOS_seqlock_t * pSeqlock)
+{
+	ASSERT(pSeqlock != NULL);
+	uint32_t sequence;
+
+	__DMB();
+	sequence = incrementSequence(pSeqlock);
+	ASSERT((sequence & 1) == 0);
+}
+
+/**
+ * @brief Writes the data protected by a seqlock from a thread.
+ *
+ * The scheduler is locked during the copy, so a higher priority reader thread does
+ * not retry while the writer thread is preempted.
+ *
+ * @param[in,out] pSeqlock Pointer to the seqlock. Must not be NULL.
+ * @param[out]    pData    Pointer to the protected data.
+ * @param[in]     pSource  Pointer to the new data.
+ * @param[in]     size     Size of the data in bytes.
+ *
+ */
+void RTOS_seqlockWrite(RTOS_seqlock_t * pSeqlock, void * pData, const void * pSource, uint32_t size)
+{
+	RTOS_SVC_schedulerLock();
+	RTOS_seqlockWriteFromISR(pSeqlock, pData, pSource, size);
+	RTOS_SVC_schedulerUnlock();
+}
+
+/**
+ * @brief Writes the data protected by a seqlock from an interrupt handler.
+ *
+ * The interrupt handler is not preempted by threads, so no lock is needed.
+ *
+ * @param[in,out] pSeqlock Pointer to the seqlock. Must not be NULL.
+ * @param[out]    pData    Pointer to the protected data.
+ * @param[in]     pSource  Pointer to the new data.
+ * @param[in]     size     Size of the data in bytes.
+ *
+ */
+void RTOS_seqlockWriteFromISR(RTOS_seqlock_t * pSeqlock, void * pData, const void * pSource, uint32_t size)
+{
+	ASSERT(pData != NULL);
+	ASSERT(pSource != NULL);
+
+	RTOS_seqlockWriteBegin(pSeqlock);
+	memcpy(pData, pSource, size);
+	RTOS_seqlockWriteEnd(pSeqlock);
+}
+
+/**
+ * @brief Starts a read of the data protected by a seqlock.
+ *
+ * Waits until no write is in progress.
+ *
+ * @param[in] pSeqlock Pointer to the seqlock. Must not be NULL.
+ *
+ * @return The sequence to pass to RTOS_seqlockReadRetry.
+ *
+ */
+uint32_t RTOS_seqlockReadBegin(const RTOS_seqlock_t * pSeqlock)
+{
+	ASSERT(pSeqlock != NULL);
+	uint32_t sequence;
+
+	do
+	{
+		sequence = pSeqlock->sequence;
+	} while((sequence & 1) == 1);
+	__DMB();
+
+	return sequence;
+}
+
+/**
+ * @brief Checks if the data read from a seqlock must be read again.
+ *
+ * @param[in] pSeqlock Pointer to the seqlock. Must not be NULL.
+ * @param[in] sequence Sequence returned by RTOS_seqlockReadBegin.
+ *
+ * @return 1 if a write happened during the read, 0 if the read data is consistent.
+ *
+ */
+uint32_t RTOS_seqlockReadRetry(const RTOS_seqlock_t * pSeqlock, uint32_t sequence)
+{
+	ASSERT(pSeqlock != NULL);
+	__DMB();
+
+	return (pSeqlock->sequence != sequence);
+}
+
+/**
+ * @brief Reads a consistent copy of the data protected by a seqlock.
+ *
+ * @param[in]  pSeqlock     Pointer to the seqlock. Must not be NULL.
+ * @param[out] pDestination Pointer to the copy.
+ * @param[in]  pData        Pointer to the protected data.
+ * @param[in]  size         Size of the data in bytes.
+ *
+ */
+void RTOS_seqlockRead(const RTOS_seqlock_t * pSeqlock, void * pDestination, const void * pData, uint32_t size)
+{
+	ASSERT(pDestination != NULL);
+	ASSERT(pData != NULL);
+	uint32_t sequence;
+
+	do
+	{
+		sequence = RTOS_seqlockReadBegin(pSeqlock);
+		memcpy(pDestination, pData, size);
+	} while(RTOS_seqlockReadRetry(pSeqlock, sequence) == 1);
+}
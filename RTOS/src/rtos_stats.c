@@ -0,0 +1,37 @@
+/*
+ * rtos_stats.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+#if (KERNEL_STATS_ENABLE == 1)
+RTOS_kernelStats_t RTOS_kernelStats;
+#endif
+
+/**
+ * @brief Takes a snapshot of the kernel statistics.
+ *
+ * Called through SVC, which no kernel path preempts, interrupts are also disabled
+ * during the copy so the snapshot is not torn.
+ *
+ * @param[out] pStats Pointer to the snapshot. Must not be NULL.
+ *
+ */
+void RTOS_getKernelStats(RTOS_kernelStats_t * pStats)
+{
+	ASSERT(pStats != NULL);
+
+#if (KERNEL_STATS_ENABLE == 1)
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	memcpy(pStats, &RTOS_kernelStats, sizeof(*pStats));
+	__set_PRIMASK(primask);
+#else
+	/* Kernel statistics are not enabled */
+	memset(pStats, 0, sizeof(*pStats));
+#endif
+}
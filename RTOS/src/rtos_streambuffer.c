@@ -0,0 +1,357 @@
+/*
+ * rtos_streambuffer.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+static void copyIn(RTOS_streamBuffer_t * pStreamBuffer, const void * pData, uint32_t length);
+static void copyOut(RTOS_streamBuffer_t * pStreamBuffer, void * pData, uint32_t length);
+static uint32_t peekMessageLength(RTOS_streamBuffer_t * pStreamBuffer);
+static uint32_t writeData(RTOS_streamBuffer_t * pStreamBuffer, const void * pData, uint32_t length);
+
+/**
+ * @brief Copies data into a stream buffer at its write index.
+ *
+ * @param[in,out] pStreamBuffer Pointer to the stream buffer.
+ * @param[in]     pData         Pointer to the data.
+ * @param[in]     length        Length of the data, must fit in the free space.
+ *
+ */
+static void copyIn(RTOS_streamBuffer_t * pStreamBuffer, const void * pData, uint32_t length)
+{
+	const uint8_t * pSource = (const uint8_t *) pData;
+	uint32_t firstLength = pStreamBuffer->bufferLength - pStreamBuffer->writeIndex;
+
+	if(firstLength > length)
+	{
+		firstLength = length;
+	}
+
+	/* Copy until the end of the buffer, then the rest from the start */
+	memcpy(&pStreamBuffer->pBuffer[pStreamBuffer->writeIndex], pSource, firstLength);
+	memcpy(pStreamBuffer->pBuffer, &pSource[firstLength], length - firstLength);
+
+	pStreamBuffer->writeIndex += length;
+	if(pStreamBuffer->writeIndex >= pStreamBuffer->bufferLength)
+	{
+		pStreamBuffer->writeIndex -= pStreamBuffer->bufferLength;
+	}
+	pStreamBuffer->usedLength += length;
+}
+
+/**
+ * @brief Copies data out of a stream buffer at its read index.
+ *
+ * @param[in,out] pStreamBuffer Pointer to the stream buffer.
+ * @param[out]    pData         Pointer to the destination.
+ * @param[in]     length        Length of the data, must not exceed the used length.
+ *
+ */
+static void copyOut(RTOS_streamBuffer_t * pStreamBuffer, void * pData, uint32_t length)
+{
+	uint8_t * pDestination = (uint8_t *) pData;
+	uint32_t firstLength = pStreamBuffer->bufferLength - pStreamBuffer->readIndex;
+
+	if(firstLength > length)
+	{
+		firstLength = length;
+	}
+
+	/* Copy until the end of the buffer, then the rest from the start */
+	memcpy(pDestination, &pStreamBuffer->pBuffer[pStreamBuffer->readIndex], firstLength);
+	memcpy(&pDestination[firstLength], pStreamBuffer->pBuffer, length - firstLength);
+
+	pStreamBuffer->readIndex += length;
+	if(pStreamBuffer->readIndex >= pStreamBuffer->bufferLength)
+	{
+		pStreamBuffer->readIndex -= pStreamBuffer->bufferLength;
+	}
+	pStreamBuffer->usedLength -= length;
+}
+
+/**
+ * @brief Gets the length of the next message in a message buffer without removing it.
+ *
+ * @param[in] pStreamBuffer Pointer to the message buffer, must not be empty.
+ *
+ * @return Length of the next message in bytes.
+ *
+ */
+static uint32_t peekMessageLength(RTOS_streamBuffer_t * pStreamBuffer)
+{
+	uint32_t messageLength;
+	uint32_t readIndex = pStreamBuffer->readIndex;
+	uint32_t usedLength = pStreamBuffer->usedLength;
+
+	copyOut(pStreamBuffer, &messageLength, MESSAGE_BUFFER_HEADER_SIZE);
+
+	/* Restore the read position */
+	pStreamBuffer->readIndex = readIndex;
+	pStreamBuffer->usedLength = usedLength;
+
+	return messageLength;
+}
+
+/**
+ * @brief Writes data or a message if it fits, and wakes up a reader if the
+ * trigger level is reached.
+ *
+ * @param[in,out] pStreamBuffer Pointer to the stream buffer.
+ * @param[in]     pData         Pointer to the data.
+ * @param[in]     length        Length of the data in bytes.
+ *
+ * @return 1 if the data is written, 0 if there is not enough free space.
+ *
+ */
+static uint32_t writeData(RTOS_streamBuffer_t * pStreamBuffer, const void * pData, uint32_t length)
+{
+	uint32_t requiredLength = length;
+	uint32_t written = 0;
+
+	if(pStreamBuffer->isMessageBuffer == 1)
+	{
+		requiredLength += MESSAGE_BUFFER_HEADER_SIZE;
+	}
+
+	if((pStreamBuffer->bufferLength - pStreamBuffer->usedLength) >= requiredLength)
+	{
+		if(pStreamBuffer->isMessageBuffer == 1)
+		{
+			copyIn(pStreamBuffer, &length, MESSAGE_BUFFER_HEADER_SIZE);
+		}
+		copyIn(pStreamBuffer, pData, length);
+
+		if(pStreamBuffer->usedLength >= pStreamBuffer->triggerLevel)
+		{
+			RTOS_threadWakeUpWaiting(&pStreamBuffer->readersWaitingList);
+			if(pStreamBuffer->pQueueSet != NULL)
+			{
+				RTOS_queueSetNotify(pStreamBuffer->pQueueSet);
+			}
+		}
+		written = 1;
+	}else
+	{
+		/* Not enough free space */
+	}
+
+	return written;
+}
+
+/**
+ * @brief Initializes a stream buffer.
+ *
+ * A stream buffer passes a stream of bytes between threads. A waiting reader is
+ * only woken up when at least the trigger level of bytes is available, or when
+ * its wait time expires.
+ *
+ * @param[out] pStreamBuffer Pointer to the stream buffer. Must not be NULL.
+ * @param[in]  pBuffer       Pointer to the memory used for the data. Must not be NULL.
+ * @param[in]  bufferLength  Length of the memory in bytes. Must be non-zero.
+ * @param[in]  triggerLevel  Bytes that wake up a waiting reader, from 1 to bufferLength.
+ *
+ */
+void RTOS_streamBufferCreate(RTOS_streamBuffer_t * pStreamBuffer, void * pBuffer,
+		uint32_t bufferLength, uint32_t triggerLevel)
+{
+	ASSERT(pStreamBuffer != NULL);
+	ASSERT(pBuffer != NULL);
+	ASSERT(bufferLength != 0);
+	ASSERT((triggerLevel != 0) && (triggerLevel <= bufferLength));
+
+	pStreamBuffer->pBuffer = (uint8_t *) pBuffer;
+	pStreamBuffer->bufferLength = bufferLength;
+	pStreamBuffer->readIndex = 0;
+	pStreamBuffer->writeIndex = 0;
+	pStreamBuffer->usedLength = 0;
+	pStreamBuffer->triggerLevel = triggerLevel;
+	pStreamBuffer->isMessageBuffer = 0;
+	pStreamBuffer->pQueueSet = NULL;
+	RTOS_listInit(&pStreamBuffer->readersWaitingList);
+	RTOS_listInit(&pStreamBuffer->writersWaitingList);
+}
+
+/**
+ * @brief Initializes a message buffer.
+ *
+ * A message buffer passes variable length messages between threads. Each message
+ * is stored with a length prefix of MESSAGE_BUFFER_HEADER_SIZE bytes and is received
+ * as a whole, a waiting reader is woken up by each message.
+ *
+ * @param[out] pMessageBuffer Pointer to the message buffer. Must not be NULL.
+ * @param[in]  pBuffer        Pointer to the memory used for the messages. Must not be NULL.
+ * @param[in]  bufferLength   Length of the memory in bytes. Must be larger than the prefix.
+ *
+ */
+void RTOS_messageBufferCreate(RTOS_messageBuffer_t * pMessageBuffer, void * pBuffer,
+		uint32_t bufferLength)
+{
+	ASSERT(bufferLength > MESSAGE_BUFFER_HEADER_SIZE);
+
+	RTOS_streamBufferCreate(pMessageBuffer, pBuffer, bufferLength, 1);
+	pMessageBuffer->isMessageBuffer = 1;
+}
+
+/**
+ * @brief Sends data to a stream buffer or a message to a message buffer, with optional
+ * blocking if there is not enough free space.
+ *
+ * The data is written as a whole. If there is not enough free space, the behavior
+ * depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is blocked until space is available.
+ * - If `waitTime` is NO_WAIT, the function returns immediately without writing the data.
+ *
+ * @param[in,out] pStreamBuffer Pointer to the stream or message buffer. Must not be NULL.
+ * @param[in]     waitTime      Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ * @param[in]     pData         Pointer to the data. Must not be NULL.
+ * @param[in]     length        Length of the data in bytes, must fit in the empty buffer.
+ *
+ * @return RTOS_SUCCESS, RTOS_FAILURE or RTOS_CONTEXT_SWITCH_TRIGGERED.
+ *
+ */
+uint32_t RTOS_streamBufferSend(RTOS_streamBuffer_t * pStreamBuffer, int32_t waitTime,
+		const void * pData, uint32_t length)
+{
+	ASSERT(pStreamBuffer != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+	ASSERT(pData != NULL);
+	ASSERT((length + (pStreamBuffer->isMessageBuffer * MESSAGE_BUFFER_HEADER_SIZE))
+			<= pStreamBuffer->bufferLength);
+
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+
+	if(writeData(pStreamBuffer, pData, length) == 1)
+	{
+		returnStatus = RTOS_SUCCESS;
+	}else if(waitTime != NO_WAIT)
+	{
+		RTOS_threadBlockRunning(&pStreamBuffer->writersWaitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No blocking required, do nothing */
+	}
+
+	return returnStatus;
+}
+
+/**
+ * @brief Sends data to a stream buffer or a message to a message buffer from an
+ * interrupt handler.
+ *
+ * A stream buffer takes as many bytes as fit, a message buffer takes the whole
+ * message or nothing. Interrupts are disabled while the buffer is updated.
+ *
+ * @param[in,out] pStreamBuffer Pointer to the stream or message buffer. Must not be NULL.
+ * @param[in]     pData         Pointer to the data. Must not be NULL.
+ * @param[in]     length        Length of the data in bytes.
+ *
+ * @return Number of bytes sent.
+ *
+ */
+uint32_t RTOS_streamBufferSendFromISR(RTOS_streamBuffer_t * pStreamBuffer,
+		const void * pData, uint32_t length)
+{
+	ASSERT(pStreamBuffer != NULL);
+	ASSERT(pData != NULL);
+
+	uint32_t primask = __get_PRIMASK();
+	uint32_t sentLength = length;
+
+	__disable_irq();
+	KERNEL_STATS_SECTION_START(entryCycle);
+
+	if((pStreamBuffer->isMessageBuffer == 0)
+			&& (sentLength > (pStreamBuffer->bufferLength - pStreamBuffer->usedLength)))
+	{
+		/* Stream is cut to the free space */
+		sentLength = pStreamBuffer->bufferLength - pStreamBuffer->usedLength;
+	}
+
+	if(writeData(pStreamBuffer, pData, sentLength) == 0)
+	{
+		sentLength = 0;
+	}
+
+	KERNEL_STATS_SECTION_END(entryCycle);
+	__set_PRIMASK(primask);
+
+	return sentLength;
+}
+
+/**
+ * @brief Receives data from a stream buffer or a message from a message buffer, with
+ * optional blocking until enough data is available.
+ *
+ * A stream buffer returns up to `length` bytes once the trigger level is reached,
+ * a message buffer returns the next whole message. If not enough data is available,
+ * the behavior depends on the `waitTime`:
+ * - If `waitTime` is not NO_WAIT, the calling thread is blocked until the trigger level
+ *   is reached. When the wait time expires, the available bytes are returned.
+ * - If `waitTime` is NO_WAIT, the available bytes are returned immediately.
+ *
+ * @param[in,out] pStreamBuffer   Pointer to the stream or message buffer. Must not be NULL.
+ * @param[in]     waitTime        Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ * @param[out]    pData           Pointer to the destination. Must not be NULL.
+ * @param[in]     length          Length of the destination in bytes.
+ * @param[out]    pReceivedLength Set to the number of bytes received.
+ *
+ * @return RTOS_SUCCESS if data is received, RTOS_FAILURE if no data is available or the
+ * next message does not fit in the destination, RTOS_CONTEXT_SWITCH_TRIGGERED if blocked.
+ *
+ */
+uint32_t RTOS_streamBufferReceive(RTOS_streamBuffer_t * pStreamBuffer, int32_t waitTime,
+		void * pData, uint32_t length, uint32_t * pReceivedLength)
+{
+	ASSERT(pStreamBuffer != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+	ASSERT(pData != NULL);
+	ASSERT(pReceivedLength != NULL);
+
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+	uint32_t receivedLength = 0;
+
+	if((pStreamBuffer->usedLength >= pStreamBuffer->triggerLevel)
+			|| ((waitTime == NO_WAIT) && (pStreamBuffer->usedLength > 0)))
+	{
+		if(pStreamBuffer->isMessageBuffer == 1)
+		{
+			receivedLength = peekMessageLength(pStreamBuffer);
+			if(receivedLength <= length)
+			{
+				copyOut(pStreamBuffer, &receivedLength, MESSAGE_BUFFER_HEADER_SIZE);
+				copyOut(pStreamBuffer, pData, receivedLength);
+				returnStatus = RTOS_SUCCESS;
+			}else
+			{
+				/* Message does not fit, keep it */
+				receivedLength = 0;
+			}
+		}else
+		{
+			receivedLength = (pStreamBuffer->usedLength < length) ? pStreamBuffer->usedLength : length;
+			copyOut(pStreamBuffer, pData, receivedLength);
+			returnStatus = RTOS_SUCCESS;
+		}
+
+		if(returnStatus == RTOS_SUCCESS)
+		{
+			/* Space is freed, a waiting writer retries */
+			RTOS_threadWakeUpWaiting(&pStreamBuffer->writersWaitingList);
+		}
+	}else if(waitTime != NO_WAIT)
+	{
+		RTOS_threadBlockRunning(&pStreamBuffer->readersWaitingList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No data available, do nothing */
+	}
+
+	*pReceivedLength = receivedLength;
+
+	return returnStatus;
+}
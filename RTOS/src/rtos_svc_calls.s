@@ -24,6 +24,44 @@
 .global RTOS_SVC_mailboxRead
 .global RTOS_SVC_threadDelay
 .global RTOS_SVC_threadDestroy
+.global RTOS_SVC_threadSetDeadline
+.global RTOS_SVC_threadSetTimeSlice
+.global RTOS_SVC_schedulerLock
+.global RTOS_SVC_schedulerUnlock
+.global RTOS_SVC_threadSetPreemptionThreshold
+.global RTOS_SVC_threadJoin
+.global RTOS_SVC_threadSetPriority
+.global RTOS_SVC_threadSuspend
+.global RTOS_SVC_threadResume
+.global RTOS_SVC_mutexCreateRecursive
+.global RTOS_SVC_rwlockCreate
+.global RTOS_SVC_rwlockReadLock
+.global RTOS_SVC_rwlockReadUnlock
+.global RTOS_SVC_rwlockWriteLock
+.global RTOS_SVC_rwlockWriteUnlock
+.global RTOS_SVC_condvarCreate
+.global RTOS_SVC_condvarWait
+.global RTOS_SVC_condvarSignal
+.global RTOS_SVC_condvarBroadcast
+.global RTOS_SVC_streamBufferCreate
+.global RTOS_SVC_messageBufferCreate
+.global RTOS_SVC_streamBufferSend
+.global RTOS_SVC_streamBufferReceive
+.global RTOS_SVC_queueSetCreate
+.global RTOS_SVC_queueSetAdd
+.global RTOS_SVC_queueSetRemove
+.global RTOS_SVC_queueSetSelect
+.global RTOS_SVC_endpointCreate
+.global RTOS_SVC_call
+.global RTOS_SVC_replyWait
+.global RTOS_SVC_msgQueueCreate
+.global RTOS_SVC_msgQueueSend
+.global RTOS_SVC_msgQueueSendToFront
+.global RTOS_SVC_msgQueueReceive
+.global RTOS_SVC_getThreadStats
+.global RTOS_SVC_threadYield
+.global RTOS_SVC_getCycleCounter
+.global RTOS_SVC_getKernelStats
 
 .text
 
@@ -91,3 +129,203 @@ RTOS_SVC_threadDelay:
 RTOS_SVC_threadDestroy:
     svc 12
  	bx lr
+
+.type RTOS_SVC_threadSetDeadline, %function
+RTOS_SVC_threadSetDeadline:
+    svc 13
+    bx lr
+
+.type RTOS_SVC_threadSetTimeSlice, %function
+RTOS_SVC_threadSetTimeSlice:
+    svc 14
+    bx lr
+
+.type RTOS_SVC_schedulerLock, %function
+RTOS_SVC_schedulerLock:
+    svc 15
+    bx lr
+
+.type RTOS_SVC_schedulerUnlock, %function
+RTOS_SVC_schedulerUnlock:
+    svc 16
+    bx lr
+
+.type RTOS_SVC_threadSetPreemptionThreshold, %function
+RTOS_SVC_threadSetPreemptionThreshold:
+    svc 17
+    bx lr
+
+.type RTOS_SVC_threadJoin, %function
+RTOS_SVC_threadJoin:
+    svc 18
+    bx lr
+
+.type RTOS_SVC_threadSetPriority, %function
+RTOS_SVC_threadSetPriority:
+    svc 19
+    bx lr
+
+.type RTOS_SVC_threadSuspend, %function
+RTOS_SVC_threadSuspend:
+    svc 20
+    bx lr
+
+.type RTOS_SVC_threadResume, %function
+RTOS_SVC_threadResume:
+    svc 21
+    bx lr
+
+.type RTOS_SVC_mutexCreateRecursive, %function
+RTOS_SVC_mutexCreateRecursive:
+    svc 22
+    bx lr
+
+.type RTOS_SVC_rwlockCreate, %function
+RTOS_SVC_rwlockCreate:
+    svc 23
+    bx lr
+
+.type RTOS_SVC_rwlockReadLock, %function
+RTOS_SVC_rwlockReadLock:
+    svc 24
+    bx lr
+
+.type RTOS_SVC_rwlockReadUnlock, %function
+RTOS_SVC_rwlockReadUnlock:
+    svc 25
+    bx lr
+
+.type RTOS_SVC_rwlockWriteLock, %function
+RTOS_SVC_rwlockWriteLock:
+    svc 26
+    bx lr
+
+.type RTOS_SVC_rwlockWriteUnlock, %function
+RTOS_SVC_rwlockWriteUnlock:
+    svc 27
+    bx lr
+
+.type RTOS_SVC_condvarCreate, %function
+RTOS_SVC_condvarCreate:
+    svc 28
+    bx lr
+
+.type RTOS_SVC_condvarWait, %function
+RTOS_SVC_condvarWait:
+    svc 29
+    bx lr
+
+.type RTOS_SVC_condvarSignal, %function
+RTOS_SVC_condvarSignal:
+    svc 30
+    bx lr
+
+.type RTOS_SVC_condvarBroadcast, %function
+RTOS_SVC_condvarBroadcast:
+    svc 31
+    bx lr
+
+.type RTOS_SVC_streamBufferCreate, %function
+RTOS_SVC_streamBufferCreate:
+    svc 32
+    bx lr
+
+.type RTOS_SVC_messageBufferCreate, %function
+RTOS_SVC_messageBufferCreate:
+    svc 33
+    bx lr
+
+.type RTOS_SVC_streamBufferSend, %function
+RTOS_SVC_streamBufferSend:
+    svc 34
+    bx lr
+
+.type RTOS_SVC_streamBufferReceive, %function
+RTOS_SVC_streamBufferReceive:
+    svc 35
+    bx lr
+
+.type RTOS_SVC_queueSetCreate, %function
+RTOS_SVC_queueSetCreate:
+    svc 36
+    bx lr
+
+.type RTOS_SVC_queueSetAdd, %function
+RTOS_SVC_queueSetAdd:
+    svc 37
+    bx lr
+
+.type RTOS_SVC_queueSetRemove, %function
+RTOS_SVC_queueSetRemove:
+    svc 38
+    bx lr
+
+.type RTOS_SVC_queueSetSelect, %function
+RTOS_SVC_queueSetSelect:
+    svc 39
+    bx lr
+
+.type RTOS_SVC_endpointCreate, %function
+RTOS_SVC_endpointCreate:
+    svc 40
+    bx lr
+
+/* Message is loaded into r1 to r3, the reply is stored back from r1 to r3 */
+.type RTOS_SVC_call, %function
+RTOS_SVC_call:
+    push {r4, lr}
+    mov r4, r1
+    ldm r4, {r1-r3}
+    svc 41
+    stm r4, {r1-r3}
+    pop {r4, pc}
+
+/* Reply is loaded into r1 to r3, the next call is stored back from r1 to r3 */
+.type RTOS_SVC_replyWait, %function
+RTOS_SVC_replyWait:
+    push {r4, lr}
+    mov r4, r1
+    ldm r4, {r1-r3}
+    svc 42
+    stm r4, {r1-r3}
+    pop {r4, pc}
+
+.type RTOS_SVC_msgQueueCreate, %function
+RTOS_SVC_msgQueueCreate:
+    svc 43
+    bx lr
+
+.type RTOS_SVC_msgQueueSend, %function
+RTOS_SVC_msgQueueSend:
+    svc 44
+    bx lr
+
+.type RTOS_SVC_msgQueueSendToFront, %function
+RTOS_SVC_msgQueueSendToFront:
+    svc 45
+    bx lr
+
+.type RTOS_SVC_msgQueueReceive, %function
+RTOS_SVC_msgQueueReceive:
+    svc 46
+    bx lr
+
+.type RTOS_SVC_getThreadStats, %function
+RTOS_SVC_getThreadStats:
+    svc 47
+    bx lr
+
+.type RTOS_SVC_threadYield, %function
+RTOS_SVC_threadYield:
+    svc 48
+    bx lr
+
+.type RTOS_SVC_getCycleCounter, %function
+RTOS_SVC_getCycleCounter:
+    svc 49
+    bx lr
+
+.type RTOS_SVC_getKernelStats, %function
+RTOS_SVC_getKernelStats:
+    svc 50
+    bx lr
@@ -9,18 +9,150 @@
 
 static RTOS_list_t readyList[THREAD_PRIORITY_LEVELS];
 static RTOS_list_t timerList;
+static RTOS_list_t suspendedList;
 static uint32_t currentTopPriority = (THREAD_PRIORITY_LEVELS - 1);
 static RTOS_thread_t * pRunningThread;
 static uint32_t runningThreadID = 0;
 static uint32_t numOfThreads = 0;
 static volatile uint32_t sysTickCounter = 0;
+static uint32_t timeSlice[THREAD_PRIORITY_LEVELS];
+static uint32_t timeSliceLeft = 0;
+static uint32_t switchDeferred = 0;
+static RTOS_thread_t * pHandoffThread = NULL;
+static RTOS_thread_t * pIdleThread = NULL;
+
+static void requestContextSwitch(void);
+static void threadExit(void);
+
+#if (THREAD_STATS_ENABLE == 1)
+static uint64_t statsTimestamp = 0;
+static uint64_t statsTotalTime = 0;
+static uint64_t statsClock = 0;
+static uint32_t statsClockLast = 0;
+
+static void updateStats(RTOS_thread_t * pPreviousThread, uint64_t now);
+
+/**
+ * @brief Extends the DWT cycle counter to 64 bits.
+ *
+ * The 32-bit counter wraps every 2^32 cycles, 23.9 s at 180 MHz. It is read at
+ * least every tick by RTOS_SysTick_Handler, so no wrap is lost. Interrupts are
+ * disabled because it is also called from interrupt handlers.
+ *
+ * @return Cycles since the counter was started.
+ */
+uint64_t RTOS_threadGetStatsClock(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	uint32_t now;
+	uint64_t clock;
+
+	__disable_irq();
+	now = DWT->CYCCNT;
+	statsClock += (uint32_t) (now - statsClockLast);
+	statsClockLast = now;
+	clock = statsClock;
+	__set_PRIMASK(primask);
+
+	return clock;
+}
+
+/**
+ * @brief Accounts a context switch in the thread statistics.
+ *
+ * A previous thread still in the ready list is preempted, otherwise it is
+ * blocked until it is added to the ready list again.
+ *
+ * @param pPreviousThread Pointer to the switched out thread, can be NULL.
+ * @param now Cycle counter at the context switch.
+ *
+ */
+static void updateStats(RTOS_thread_t * pPreviousThread, uint64_t now)
+{
+	if(pPreviousThread != pRunningThread)
+	{
+		pRunningThread->stats.switchCount++;
+
+		if(pPreviousThread != NULL)
+		{
+			if(pPreviousThread->listItem.pList == &readyList[pPreviousThread->priority])
+			{
+				pPreviousThread->stats.preemptCount++;
+			}else
+			{
+				pPreviousThread->stats.blocked = 1;
+				pPreviousThread->stats.blockedSince = now;
+			}
+		}
+	}
+}
+#endif
+
+/**
+ * @brief Triggers a context switch, or defers it while the running thread
+ * locks the scheduler.
+ *
+ */
+static void requestContextSwitch(void)
+{
+	if(pRunningThread->schedulerLockCount > 0)
+	{
+		/* Switch when the scheduler is unlocked */
+		switchDeferred = 1;
+	}else
+	{
+		/* Trigger context switching */
+		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	}
+}
+
+#if (EDF_ENABLE == 1)
+static void edfRelease(RTOS_thread_t * pThread);
+
+/**
+ * @brief Starts a new release of an EDF thread.
+ *
+ * The absolute deadline of the release is the current tick plus the
+ * relative deadline of the thread.
+ *
+ * @param pThread Pointer to the released thread.
+ *
+ */
+static void edfRelease(RTOS_thread_t * pThread)
+{
+	pThread->absoluteDeadline = sysTickCounter + pThread->relativeDeadline;
+	if(pThread->absoluteDeadline < sysTickCounter)
+	{
+		ASSERT(0);
+	}
+}
+#endif
+
+/**
+ * @brief Exit trampoline of all threads.
+ *
+ * The thread function returns here, the thread is destroyed and its joiners
+ * are woken up.
+ *
+ */
+static void threadExit(void)
+{
+	RTOS_SVC_threadDestroy(RTOS_threadGetRunning());
+
+	/* Destroyed thread is never scheduled again */
+	while(1)
+	{
+
+	}
+}
 
 /**
  * @brief Initializes the ready lists for all thread priority levels.
  *
  * This function sets up the ready lists used by the RTOS to manage threads
  * at different priority levels. Each priority level is associated with its
- * own list, and all lists are initialized to an empty state.
+ * own list, and all lists are initialized to an empty state. Each priority
+ * level starts with the default time slice.
  *
  */
 void RTOS_threadInitLists(void)
@@ -28,8 +160,14 @@ void RTOS_threadInitLists(void)
 	for(uint32_t priority = 0; priority < THREAD_PRIORITY_LEVELS; priority++)
 	{
 		RTOS_listInit(&readyList[priority]);
+		timeSlice[priority] = THREAD_TIME_SLICE_TICKS;
 	}
+#if (EDF_ENABLE == 1)
+	/* EDF threads run until an earlier deadline is released */
+	timeSlice[EDF_PRIORITY_LEVEL] = 0;
+#endif
 	RTOS_listInit(&timerList);
+	RTOS_listInit(&suspendedList);
 }
 
 /**
@@ -41,10 +179,12 @@ void RTOS_threadInitLists(void)
  * @param pThread Pointer to the RTOS_thread_t structure for the thread.
  * @param pStack Pointer to the memory allocated for the thread's stack.
  * @param priority Priority level of the thread, must be less than THREAD_PRIORITY_LEVELS.
- * @param pFunction Pointer to the thread's entry function.
+ * @param pFunction Pointer to the thread's entry function, returning from it destroys the thread.
+ * @param pArg Argument passed to the thread's entry function.
  *
  */
-void RTOS_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t priority, void * pFunction)
+void RTOS_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t priority,
+		RTOS_threadFunction_t pFunction, void * pArg)
 {
 	/* Check input parameters */
 	ASSERT(pThread != NULL);
@@ -59,6 +199,12 @@ void RTOS_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t
 	/* Write thread function into return address */
 	MEM32_ADDRESS((pThread->pStackPointer + (16 << 2))) = (uint32_t) pFunction;
 
+	/* Write the thread function argument into R0 */
+	MEM32_ADDRESS((pThread->pStackPointer + (10 << 2))) = (uint32_t) pArg;
+
+	/* Write the exit trampoline into LR, the thread function returns to it */
+	MEM32_ADDRESS((pThread->pStackPointer + (15 << 2))) = (uint32_t) threadExit;
+
 	/* Write initial xPSR, program status register, thumb */
 	MEM32_ADDRESS((pThread->pStackPointer + (17 << 2))) = 0x01000000;
 
@@ -87,6 +233,35 @@ void RTOS_threadCreate(RTOS_thread_t * pThread, RTOS_stack_t * pStack, uint32_t
 
 	pThread->eventListItem.itemValue = priority;
 
+	/* No threads are joining yet */
+	RTOS_listInit(&pThread->joinList);
+	pThread->terminated = 0;
+	pThread->pOwnedMutexes = NULL;
+	pThread->pCondvarMutex = NULL;
+	pThread->pHandoverRwlock = NULL;
+	pThread->condvarState = CONDVAR_NOT_WAITING;
+	pThread->pIpcFrame = NULL;
+	pThread->pIpcClient = NULL;
+	pThread->pIpcServer = NULL;
+	pThread->pIpcEndpoint = NULL;
+	pThread->ipcBasePriority = priority;
+	memset(&pThread->stats, 0, sizeof(pThread->stats));
+
+	/* Preemptible by any higher priority thread, scheduler not locked */
+	pThread->preemptionThreshold = priority;
+	pThread->schedulerLockCount = 0;
+
+	/* No EDF deadline until RTOS_threadSetDeadline */
+	pThread->relativeDeadline = 0;
+	pThread->absoluteDeadline = 0;
+
+	RTOS_HOOK_THREAD_CREATED(pThread);
+
+#if (EDF_ENABLE == 1)
+	/* Creation is the first release of the thread */
+	edfRelease(pThread);
+#endif
+
 	RTOS_threadAddToReadyList(pThread);
 }
 
@@ -111,35 +286,125 @@ RTOS_thread_t * RTOS_threadGetCurrentReady(void)
  *
  * This function updates the currently running thread by finding the highest-priority
  * thread that is ready to run. It cycles through the ready list of threads to
- * determine the next thread to execute.
+ * determine the next thread to execute. The running thread is kept while it
+ * locks the scheduler or while no ready thread is above its preemption threshold.
+ * A handoff thread at the top priority is switched in directly.
  *
  */
 void RTOS_threadSwitchRunning(void)
 {
-	/* Find highest priority ready thread */
-	while(readyList[currentTopPriority].numOfItems == 0)
+	KERNEL_STATS_SECTION_START(entryCycle);
+	RTOS_thread_t * pHandoff = pHandoffThread;
+	RTOS_thread_t * pPreviousThread = pRunningThread;
+	pHandoffThread = NULL;
+
+#if (THREAD_STATS_ENABLE == 1)
+	uint64_t now = RTOS_threadGetStatsClock();
+
+	/* Charge the elapsed cycles to the switched out thread */
+	if(pPreviousThread != NULL)
 	{
-		ASSERT(THREAD_PRIORITY_LEVELS > currentTopPriority);
-		currentTopPriority++;
+		pPreviousThread->stats.runTime += now - statsTimestamp;
+		statsTotalTime += now - statsTimestamp;
 	}
+	statsTimestamp = now;
+#endif
 
-	/* Threads are found, update list index to the next thread */
-	RTOS_list_t * pReadyList = &readyList[currentTopPriority];
-	pReadyList->pIndex = pReadyList->pIndex->pNext;
-
-	/* Check if the new index pointing to the end of the list */
-	if(pReadyList->pIndex == (RTOS_listItem_t *) &pReadyList->listEnd)
+	if((pHandoff != NULL) && (pHandoff->listItem.pList == &readyList[pHandoff->priority])
+			&& (pHandoff->priority <= currentTopPriority))
 	{
-		/* Get the next thread */
-		pReadyList->pIndex = pReadyList->pIndex->pNext;
+		/* Direct switch, no ready list search */
+		switchDeferred = 0;
+		currentTopPriority = pHandoff->priority;
+		readyList[currentTopPriority].pIndex = &pHandoff->listItem;
+		pRunningThread = pHandoff;
+		runningThreadID = pRunningThread->threadID;
+		timeSliceLeft = timeSlice[currentTopPriority];
 	}else
 	{
-		/* Do nothing, index is not pointing to the end */
+		/* Find highest priority ready thread */
+		while(readyList[currentTopPriority].numOfItems == 0)
+		{
+			ASSERT(THREAD_PRIORITY_LEVELS > currentTopPriority);
+			currentTopPriority++;
+		}
+
+		/* Keep the running thread while it locks the scheduler, or while no ready
+		 * thread is above its preemption threshold */
+		if((pRunningThread != NULL)
+				&& (pRunningThread->listItem.pList == &readyList[pRunningThread->priority])
+				&& ((pRunningThread->schedulerLockCount > 0)
+						|| ((pRunningThread->preemptionThreshold < pRunningThread->priority)
+								&& (currentTopPriority >= pRunningThread->preemptionThreshold))))
+		{
+			if(pRunningThread->schedulerLockCount > 0)
+			{
+				/* Switch when the scheduler is unlocked */
+				switchDeferred = 1;
+			}
+		}else
+		{
+			switchDeferred = 0;
+
+			/* Threads are found, update list index to the next thread */
+			RTOS_list_t * pReadyList = &readyList[currentTopPriority];
+
+#if (EDF_ENABLE == 1)
+			if(currentTopPriority == EDF_PRIORITY_LEVEL)
+			{
+				/* EDF list is sorted, the earliest deadline is the first item */
+				pReadyList->pIndex = pReadyList->listEnd.pNext;
+			}else
+#endif
+			{
+				pReadyList->pIndex = pReadyList->pIndex->pNext;
+
+				/* Check if the new index pointing to the end of the list */
+				if(pReadyList->pIndex == (RTOS_listItem_t *) &pReadyList->listEnd)
+				{
+					/* Get the next thread */
+					pReadyList->pIndex = pReadyList->pIndex->pNext;
+				}else
+				{
+					/* Do nothing, index is not pointing to the end */
+				}
+			}
+
+			/* Update current running thread */
+			pRunningThread = (RTOS_thread_t *) pReadyList->pIndex->pThread;
+			runningThreadID = pRunningThread->threadID;
+
+			/* Start a new time slice */
+			timeSliceLeft = timeSlice[currentTopPriority];
+		}
+	}
+
+	if(pPreviousThread != pRunningThread)
+	{
+		KERNEL_STATS_COUNT(contextSwitches);
+
+		if(pPreviousThread != NULL)
+		{
+			RTOS_HOOK_THREAD_SWITCHED_OUT(pPreviousThread);
+			if(pPreviousThread == pIdleThread)
+			{
+				RTOS_HOOK_IDLE_EXIT();
+			}
+		}
+
+		if(pRunningThread == pIdleThread)
+		{
+			RTOS_HOOK_IDLE_ENTER();
+		}
+		RTOS_TRACE(TRACE_EVENT_THREAD_SWITCH, pRunningThread->threadID);
+		RTOS_HOOK_THREAD_SWITCHED_IN(pRunningThread);
 	}
 
-	/* Update current running thread */
-	pRunningThread = (RTOS_thread_t *) pReadyList->pIndex->pThread;
-	runningThreadID = pRunningThread->threadID;
+#if (THREAD_STATS_ENABLE == 1)
+	updateStats(pPreviousThread, now);
+#endif
+
+	KERNEL_STATS_SECTION_END(entryCycle);
 }
 
 /**
@@ -160,10 +425,11 @@ RTOS_thread_t * RTOS_threadGetRunning(void)
  * @brief Adds a thread to the ready list and manages priority-based scheduling.
  *
  * This function inserts a thread into the ready list corresponding to its priority level.
+ * Threads of the EDF priority level are inserted in absolute deadline order.
  * It updates the system's top priority if the added thread has a higher priority
- * (lower numerical value). If the added thread's priority is higher than the currently
- * running thread, a context switch is triggered to ensure the highest-priority thread
- * executes.
+ * (lower numerical value). If the added thread's priority is higher than the preemption
+ * threshold of the currently running thread, a context switch is triggered to ensure
+ * the highest-priority thread executes.
  *
  * @param[in,out] pThread Pointer to the thread to be added to the ready list.
  *                        Must not be NULL.
@@ -172,16 +438,45 @@ RTOS_thread_t * RTOS_threadGetRunning(void)
 void RTOS_threadAddToReadyList(RTOS_thread_t * pThread)
 {
 	ASSERT(pThread != NULL);
-	RTOS_listInsertEnd(&readyList[pThread->priority], &pThread->listItem);
+	uint32_t preempt = 0;
+
+	RTOS_TRACE(TRACE_EVENT_THREAD_READY, pThread->threadID);
+
+#if (THREAD_STATS_ENABLE == 1)
+	if(pThread->stats.blocked == 1)
+	{
+		pThread->stats.blocked = 0;
+		pThread->stats.blockedTime += RTOS_threadGetStatsClock() - pThread->stats.blockedSince;
+	}
+#endif
+
+#if (EDF_ENABLE == 1)
+	if(pThread->priority == EDF_PRIORITY_LEVEL)
+	{
+		pThread->listItem.itemValue = pThread->absoluteDeadline;
+		RTOS_listInsert(&readyList[EDF_PRIORITY_LEVEL], &pThread->listItem);
+
+		/* An earlier deadline preempts the running EDF thread */
+		if((pRunningThread != NULL) && (pThread->priority == pRunningThread->priority)
+				&& (pThread->absoluteDeadline < pRunningThread->absoluteDeadline))
+		{
+			preempt = 1;
+		}
+	}else
+#endif
+	{
+		RTOS_listInsertEnd(&readyList[pThread->priority], &pThread->listItem);
+	}
+
 	if(pThread->priority < currentTopPriority)
 	{
 		currentTopPriority = pThread->priority;
 	}
 
-	if((pThread != NULL) && (pThread->priority < pRunningThread->priority))
+	/* No thread is running before the scheduler starts */
+	if((pRunningThread != NULL) && ((pThread->priority < pRunningThread->preemptionThreshold) || (preempt == 1)))
 	{
-		/* Trigger context switching */
-		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+		requestContextSwitch();
 	}else
 	{
 		/* Context switching is not required */
@@ -189,6 +484,33 @@ void RTOS_threadAddToReadyList(RTOS_thread_t * pThread)
 
 }
 
+/**
+ * @brief Switches directly to a ready thread at the next context switch.
+ *
+ * Used when the running thread blocks and passes the CPU to its IPC partner.
+ * The handoff is ignored if a higher priority thread is ready meanwhile.
+ *
+ * @param[in] pThread Pointer to a thread in the ready list. Must not be NULL.
+ *
+ */
+void RTOS_threadHandoff(RTOS_thread_t * pThread)
+{
+	ASSERT(pThread != NULL);
+	pHandoffThread = pThread;
+}
+
+/**
+ * @brief Registers the idle thread for the idle entry and exit hooks.
+ *
+ * @param[in] pThread Pointer to the idle thread. Must not be NULL.
+ *
+ */
+void RTOS_threadSetIdle(RTOS_thread_t * pThread)
+{
+	ASSERT(pThread != NULL);
+	pIdleThread = pThread;
+}
+
 /**
  * @brief Updates the timer list and moves threads ready for execution to the ready list.
  *
@@ -200,6 +522,7 @@ void RTOS_threadAddToReadyList(RTOS_thread_t * pThread)
 void RTOS_threadRefreshTimerList(void)
 {
 	RTOS_thread_t * pThread;
+	uint32_t wokenNum = 0;
 	if(RTOS_isSchedulerRunning())
 	{
 		sysTickCounter++;
@@ -209,21 +532,91 @@ void RTOS_threadRefreshTimerList(void)
 		}
 		if(timerList.numOfItems > 0)
 		{
-			while(sysTickCounter >= timerList.listEnd.pNext->itemValue)
+			while((timerList.numOfItems > 0) && (sysTickCounter >= timerList.listEnd.pNext->itemValue))
 			{
 				pThread = timerList.listEnd.pNext->pThread;
 				ASSERT(pThread != NULL);
+				RTOS_TRACE(TRACE_EVENT_TIMER_EXPIRE, pThread->threadID);
+				RTOS_HOOK_TIMER_EXPIRED(pThread);
 				RTOS_listRemove(&pThread->listItem);
 				if(pThread->eventListItem.pList != NULL)
 				{
 					RTOS_listRemove(&pThread->eventListItem);
 				}
+#if (EDF_ENABLE == 1)
+				else
+				{
+					/* End of a delay is the next release of the thread */
+					edfRelease(pThread);
+				}
+#endif
 				RTOS_threadAddToReadyList(pThread);
+				wokenNum++;
+			}
+			KERNEL_STATS_MAX(maxWokenPerTick, wokenNum);
+		}
+	}
+}
+
+/**
+ * @brief Returns the system tick counter.
+ *
+ * Only reads memory, so it can be called from unprivileged threads without SVC.
+ *
+ * @return Ticks since the scheduler start.
+ */
+uint32_t RTOS_threadGetTickCount(void)
+{
+	return sysTickCounter;
+}
+
+/**
+ * @brief Consumes one tick of the running thread time slice.
+ *
+ * When the time slice expires and other threads of the same priority are ready,
+ * a context switch is triggered to run the next one. A thread alone at its
+ * priority level starts a new time slice instead, so no context switch is done.
+ * Levels with a zero time slice and the EDF level never switch on time slice.
+ *
+ */
+void RTOS_threadUpdateTimeSlice(void)
+{
+	if(RTOS_isSchedulerRunning() && (timeSliceLeft > 0))
+	{
+		timeSliceLeft--;
+		if(timeSliceLeft == 0)
+		{
+			if(readyList[pRunningThread->priority].numOfItems > 1)
+			{
+				requestContextSwitch();
+			}else
+			{
+				/* Thread is alone at its priority, keep running */
+				timeSliceLeft = timeSlice[pRunningThread->priority];
 			}
 		}
 	}
 }
 
+/**
+ * @brief Sets the round-robin time slice of a priority level.
+ *
+ * The new time slice is used from the next time a thread of this priority
+ * level is switched in.
+ *
+ * @param priority Priority level, must be less than THREAD_PRIORITY_LEVELS.
+ * @param ticks Time slice in ticks, 0 disables round-robin at this level.
+ *
+ */
+void RTOS_threadSetTimeSlice(uint32_t priority, uint32_t ticks)
+{
+	ASSERT(THREAD_PRIORITY_LEVELS > priority);
+#if (EDF_ENABLE == 1)
+	ASSERT(EDF_PRIORITY_LEVEL != priority);
+#endif
+	timeSlice[priority] = ticks;
+}
+
 /**
  * @brief Moves the currently running thread to the timer list for delayed execution.
  *
@@ -244,16 +637,85 @@ void RTOS_threadAddRunningToTimerList(uint32_t waitTime)
 		ASSERT(0);
 	}
 	pRunningThread->listItem.itemValue = wakeUpTick;
-	RTOS_listRemove(&pRunningThread->listItem);
+	if(pRunningThread->listItem.pList != NULL)
+	{
+		/* Still in the ready list, not blocked on an object */
+		RTOS_listRemove(&pRunningThread->listItem);
+	}
 	RTOS_listInsert(&timerList, &pRunningThread->listItem);
+	KERNEL_STATS_MAX(timerListHighWater, timerList.numOfItems);
 	SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 }
 
+/**
+ * @brief Blocks the running thread on a waiting list.
+ *
+ * The running thread leaves the ready list and waits in the waiting list in
+ * priority order, a context switch is triggered. With a positive wait time the
+ * thread is also added to the timer list and wakes up when it expires.
+ *
+ * @param pWaitingList Pointer to the waiting list of the object. Must not be NULL.
+ * @param waitTime Wait time in ticks or WAIT_INDEFINITELY.
+ *
+ */
+void RTOS_threadBlockRunning(RTOS_list_t * pWaitingList, int32_t waitTime)
+{
+	ASSERT(pWaitingList != NULL);
+	RTOS_TRACE(TRACE_EVENT_THREAD_BLOCK, pWaitingList);
+	RTOS_HOOK_THREAD_BLOCKED(pRunningThread, pWaitingList);
+	RTOS_listRemove(&pRunningThread->listItem);
+	RTOS_listInsert(pWaitingList, &pRunningThread->eventListItem);
+	KERNEL_STATS_MAX(waitingListHighWater, pWaitingList->numOfItems);
+	SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	if(waitTime > NO_WAIT)
+	{
+		RTOS_threadAddRunningToTimerList(waitTime);
+	}
+}
+
+/**
+ * @brief Wakes up the highest priority thread of a waiting list.
+ *
+ * The thread is removed from the waiting list and from the timer list,
+ * then added to the ready list.
+ *
+ * @param pWaitingList Pointer to the waiting list of the object. Must not be NULL.
+ *
+ * @return Pointer to the woken thread, NULL if no thread is waiting.
+ *
+ */
+RTOS_thread_t * RTOS_threadWakeUpWaiting(RTOS_list_t * pWaitingList)
+{
+	ASSERT(pWaitingList != NULL);
+	RTOS_thread_t * pThread = NULL;
+
+	/* Get highest priority waiting thread, the one next from the end */
+	if(pWaitingList->numOfItems > 0)
+	{
+		pThread = pWaitingList->listEnd.pNext->pThread;
+		ASSERT(pThread != NULL);
+		RTOS_HOOK_THREAD_WOKEN(pThread, pWaitingList);
+		RTOS_listRemove(&pThread->eventListItem);
+		if(pThread->listItem.pList != NULL)
+		{
+			RTOS_listRemove(&pThread->listItem);
+		}
+		RTOS_threadAddToReadyList(pThread);
+	}else
+	{
+		/* No threads are waiting, do nothing */
+	}
+
+	return pThread;
+}
+
 /**
  * @brief Destroys a thread and removes it from all associated lists.
  *
  * This function performs the necessary cleanup for a thread by removing it
  * from any system lists it is part of (ready list, event list, etc.).
+ * The mutexes held by the thread are handed over to their waiting threads.
+ * Threads joining the destroyed thread are woken up.
  * If the thread being destroyed is currently running, it triggers a context
  * switch to ensure proper RTOS behavior.
  *
@@ -273,9 +735,334 @@ void RTOS_threadDestroy(RTOS_thread_t * pThread)
 		RTOS_listRemove(&pThread->eventListItem);
 	}
 
+	/* Pass the held mutexes to their waiting threads */
+	RTOS_mutexReleaseOwned(pThread);
+
+	/* Pass on a write lock handed over before the thread retried */
+	RTOS_rwlockReleaseThread(pThread);
+
+	/* End the calls served or made by the thread */
+	RTOS_ipcReleaseThread(pThread);
+
+	/* Wake up all joining threads */
+	pThread->terminated = 1;
+	while(RTOS_threadWakeUpWaiting(&pThread->joinList) != NULL)
+	{
+
+	}
+
+	RTOS_HOOK_THREAD_DESTROYED(pThread);
+
+	if(pThread == pRunningThread)
+	{
+		/* Trigger context switching */
+		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	}
+}
+
+/**
+ * @brief Waits for a thread to terminate.
+ *
+ * If the thread is already destroyed the function returns immediately,
+ * otherwise the running thread waits in the join list of the thread.
+ *
+ * @param pThread Pointer to the thread to join. Must not be the running thread.
+ * @param waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ *
+ * @return RTOS_SUCCESS if the thread terminated, RTOS_FAILURE if it is still
+ * running, RTOS_CONTEXT_SWITCH_TRIGGERED if the running thread is blocked.
+ *
+ */
+uint32_t RTOS_threadJoin(RTOS_thread_t * pThread, int32_t waitTime)
+{
+	ASSERT(pThread != NULL);
+	ASSERT(pThread != pRunningThread);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+
+	RTOS_return_t returnStatus = RTOS_FAILURE;
+
+	if(pThread->terminated == 1)
+	{
+		returnStatus = RTOS_SUCCESS;
+	}else if(waitTime != NO_WAIT)
+	{
+		RTOS_threadBlockRunning(&pThread->joinList, waitTime);
+		returnStatus = RTOS_CONTEXT_SWITCH_TRIGGERED;
+	}else
+	{
+		/* No blocking required, do nothing */
+	}
+
+	return returnStatus;
+}
+
+/**
+ * @brief Sets the relative deadline of an EDF thread.
+ *
+ * The thread gets a new release with the given relative deadline. Following
+ * releases happen when the thread wakes up from a delay. If the thread is ready
+ * it is moved to its new place in the EDF ready list.
+ *
+ * @param pThread Pointer to the thread, its priority must be EDF_PRIORITY_LEVEL.
+ * @param relativeDeadline Deadline in ticks counted from each release.
+ *
+ */
+void RTOS_threadSetDeadline(RTOS_thread_t * pThread, uint32_t relativeDeadline)
+{
+	ASSERT(pThread != NULL);
+#if (EDF_ENABLE == 1)
+	ASSERT(pThread->priority == EDF_PRIORITY_LEVEL);
+
+	pThread->relativeDeadline = relativeDeadline;
+	edfRelease(pThread);
+
+	if(pThread->listItem.pList == &readyList[EDF_PRIORITY_LEVEL])
+	{
+		RTOS_listRemove(&pThread->listItem);
+		RTOS_threadAddToReadyList(pThread);
+
+		if(pThread == pRunningThread)
+		{
+			/* Deadline moved later, another EDF thread may be earlier now */
+			SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+		}
+	}
+#else
+	/* EDF class is not enabled */
+	ASSERT(0);
+#endif
+}
+
+/**
+ * @brief Sets the preemption threshold of a thread.
+ *
+ * While the thread runs, it is only preempted by threads with a priority higher
+ * than the threshold. Threads between the threshold and the thread priority,
+ * including the same priority, wait until it blocks.
+ *
+ * @param pThread Pointer to the thread. Must not be NULL.
+ * @param preemptionThreshold Threshold priority, from 0 to the thread priority.
+ * The thread priority restores normal preemption.
+ *
+ */
+void RTOS_threadSetPreemptionThreshold(RTOS_thread_t * pThread, uint32_t preemptionThreshold)
+{
+	ASSERT(pThread != NULL);
+	ASSERT(pThread->priority >= preemptionThreshold);
+
+	pThread->preemptionThreshold = preemptionThreshold;
+
 	if(pThread == pRunningThread)
 	{
+		/* Threads waiting for a lower threshold may run now */
+		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	}
+}
+
+/**
+ * @brief Locks the scheduler for the running thread.
+ *
+ * The running thread is not preempted by other threads until it unlocks the
+ * scheduler, interrupts are still enabled. Context switches requested meanwhile
+ * are deferred to the last unlock. Locks can be nested.
+ *
+ */
+void RTOS_schedulerLock(void)
+{
+	ASSERT(pRunningThread != NULL);
+	pRunningThread->schedulerLockCount++;
+}
+
+/**
+ * @brief Unlocks the scheduler for the running thread.
+ *
+ * The last unlock triggers the context switches deferred while the scheduler was locked.
+ *
+ */
+void RTOS_schedulerUnlock(void)
+{
+	ASSERT(pRunningThread != NULL);
+	ASSERT(pRunningThread->schedulerLockCount > 0);
+
+	pRunningThread->schedulerLockCount--;
+	if((pRunningThread->schedulerLockCount == 0) && (switchDeferred == 1))
+	{
+		switchDeferred = 0;
 		/* Trigger context switching */
 		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 	}
 }
+
+/**
+ * @brief Changes the priority of a thread at run time.
+ *
+ * A ready thread is moved to the ready list of its new priority, a waiting thread
+ * is moved to its new place in the priority sorted waiting list. A preemption
+ * threshold equal to the old priority follows the new priority.
+ *
+ * @param pThread Pointer to the thread. Must not be NULL.
+ * @param priority New priority, must be less than THREAD_PRIORITY_LEVELS.
+ *
+ */
+void RTOS_threadSetPriority(RTOS_thread_t * pThread, uint32_t priority)
+{
+	ASSERT(pThread != NULL);
+	ASSERT(THREAD_PRIORITY_LEVELS > priority);
+
+	RTOS_list_t * pWaitingList;
+	uint32_t oldPriority = pThread->priority;
+
+	if((pThread->preemptionThreshold == oldPriority) || (pThread->preemptionThreshold > priority))
+	{
+		pThread->preemptionThreshold = priority;
+	}
+
+	if(pThread->listItem.pList == &readyList[oldPriority])
+	{
+		/* Move to the ready list of the new priority */
+		RTOS_listRemove(&pThread->listItem);
+		pThread->priority = priority;
+		RTOS_threadAddToReadyList(pThread);
+	}else
+	{
+		pThread->priority = priority;
+	}
+
+	pThread->eventListItem.itemValue = priority;
+	if(pThread->eventListItem.pList != NULL)
+	{
+		/* Keep the waiting list sorted by priority */
+		pWaitingList = (RTOS_list_t *) pThread->eventListItem.pList;
+		RTOS_listRemove(&pThread->eventListItem);
+		RTOS_listInsert(pWaitingList, &pThread->eventListItem);
+	}
+
+	if((pThread == pRunningThread) && (priority > oldPriority))
+	{
+		/* Running thread is lowered, another thread may be higher now */
+		SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+	}
+}
+
+/**
+ * @brief Passes the CPU to the next ready thread of the same priority.
+ *
+ * The running thread stays ready, a context switch is only triggered when
+ * another thread of its priority is ready.
+ *
+ */
+void RTOS_threadYield(void)
+{
+	ASSERT(pRunningThread != NULL);
+
+	if(readyList[pRunningThread->priority].numOfItems > 1)
+	{
+		requestContextSwitch();
+	}else
+	{
+		/* Thread is alone at its priority, keep running */
+	}
+}
+
+/**
+ * @brief Suspends a thread until it is resumed.
+ *
+ * The thread is removed from the ready list, or from the timer and waiting lists
+ * if it is blocked. A blocked thread retries its call when it is resumed, a timed
+ * wait then ends as timed out.
+ *
+ * @param pThread Pointer to the thread. Must not be NULL or destroyed.
+ *
+ */
+void RTOS_threadSuspend(RTOS_thread_t * pThread)
+{
+	ASSERT(pThread != NULL);
+	ASSERT(pThread->terminated == 0);
+
+	if(pThread->listItem.pList != &suspendedList)
+	{
+		if(pThread->listItem.pList != NULL)
+		{
+			RTOS_listRemove(&pThread->listItem);
+		}
+
+		if(pThread->eventListItem.pList != NULL)
+		{
+			RTOS_listRemove(&pThread->eventListItem);
+		}
+
+		RTOS_listInsertEnd(&suspendedList, &pThread->listItem);
+
+		if(pThread == pRunningThread)
+		{
+			/* Trigger context switching */
+			SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
+		}
+	}else
+	{
+		/* Already suspended, do nothing */
+	}
+}
+
+/**
+ * @brief Resumes a suspended thread.
+ *
+ * @param pThread Pointer to the thread. Must not be NULL.
+ *
+ */
+void RTOS_threadResume(RTOS_thread_t * pThread)
+{
+	ASSERT(pThread != NULL);
+
+	if(pThread->listItem.pList == &suspendedList)
+	{
+		RTOS_listRemove(&pThread->listItem);
+		RTOS_threadAddToReadyList(pThread);
+	}else
+	{
+		/* Not suspended, do nothing */
+	}
+}
+
+/**
+ * @brief Gets the run time statistics of a thread.
+ *
+ * The CPU load is the run time of the thread relative to the CPU time since the
+ * scheduler started, the running thread is charged until now. The system load is
+ * filled in by RTOS_getThreadStats.
+ *
+ * @param pThread Pointer to the thread. Must not be NULL.
+ * @param pReport Pointer to the statistics report. Must not be NULL.
+ *
+ */
+void RTOS_threadGetStats(RTOS_thread_t * pThread, RTOS_threadStatsReport_t * pReport)
+{
+	ASSERT(pThread != NULL);
+	ASSERT(pReport != NULL);
+
+#if (THREAD_STATS_ENABLE == 1)
+	uint64_t now = RTOS_threadGetStatsClock();
+	uint64_t elapsed = now - statsTimestamp;
+	uint64_t totalTime = statsTotalTime + elapsed;
+
+	pReport->runTime = pThread->stats.runTime;
+	if(pThread == pRunningThread)
+	{
+		pReport->runTime += elapsed;
+	}
+
+	pReport->blockedTime = pThread->stats.blockedTime;
+	if(pThread->stats.blocked == 1)
+	{
+		pReport->blockedTime += now - pThread->stats.blockedSince;
+	}
+
+	pReport->switchCount = pThread->stats.switchCount;
+	pReport->preemptCount = pThread->stats.preemptCount;
+	pReport->cpuLoad = (totalTime > 0) ? (uint32_t) ((pReport->runTime * 1000u) / totalTime) : 0;
+	pReport->systemLoad = 0;
+#else
+	/* Run time accounting is not enabled */
+	memset(pReport, 0, sizeof(*pReport));
+#endif
+}
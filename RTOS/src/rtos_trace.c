@@ -0,0 +1,32 @@
+/*
+ * rtos_trace.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#include "rtos.h"
+
+#if (TRACE_ENABLE == 1)
+
+RTOS_traceBuffer_t RTOS_traceBuffer;
+
+/**
+ * @brief Initializes the trace buffer, the DWT cycle counter is started by RTOS_init.
+ *
+ * The buffer is found in a RAM dump by its magic word and decoded on the host
+ * by tools/trace_decode.py.
+ *
+ */
+void RTOS_traceInit(void)
+{
+	/* Ring index is masked, size must be a power of two */
+	ASSERT((TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) == 0);
+
+	RTOS_traceBuffer.clockHz = SYSTEM_CORE_CLOCK_HZ;
+	RTOS_traceBuffer.eventsNum = TRACE_BUFFER_EVENTS;
+	RTOS_traceBuffer.writeCount = 0;
+	RTOS_traceBuffer.magic = TRACE_MAGIC;
+}
+
+#endif
@@ -0,0 +1,360 @@
+/*
+ * benchmark.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+/*
+ * Kernel hot path benchmarks.
+ *
+ * Threads are unprivileged and can not read the DWT cycle counter, they take
+ * timestamps with RTOS_SVC_getCycleCounter. The cost of one timestamp, measured
+ * first, is subtracted from the thread to thread results. Each benchmark prints
+ * one CSV line of cycles: name,samples,min,mean,max,p50,p90,p99.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "rtos.h"
+#include "uart_console.h"
+#include "benchmark.h"
+
+#if (BENCHMARK_ENABLE == 1)
+
+#define CONTROLLER_PRIORITY		(THREAD_PRIORITY_LEVELS - 2)
+#define WORKER_PRIORITY_HIGH	((uint32_t) 2u)
+#define WORKER_PRIORITY_LOW		((uint32_t) 3u)
+#define BENCHMARK_IRQ			EXTI0_IRQn
+
+typedef struct
+{
+	const char * pName;
+	RTOS_threadFunction_t pWorkerHigh;
+	RTOS_threadFunction_t pWorkerLow;
+	uint32_t samePriority;		/* 1 to run both workers at the low priority */
+} benchmark_t;
+
+static RTOS_thread_t controllerThread;
+static RTOS_stack_t controllerStack;
+static RTOS_thread_t workerThreads[2];
+static RTOS_stack_t workerStacks[2];
+
+static RTOS_semaphore_t semaphores[2];
+static RTOS_mutex_t mutex;
+static RTOS_mailbox_t mailboxes[2];
+static uint32_t mailboxBuffers[2][4];
+
+static uint32_t samples[BENCHMARK_ITERATIONS];
+static volatile uint32_t samplesNum;
+static volatile uint32_t startStamp;
+static volatile uint32_t isrStamp;
+static uint32_t timestampOverhead;
+
+static void addSample(uint32_t cycles);
+static uint32_t elapsed(uint32_t start);
+static int compareSamples(const void * pFirst, const void * pSecond);
+static void report(const char * pName);
+static void yieldWorker(void * pArg);
+static void semaphoreWorkerHigh(void * pArg);
+static void semaphoreWorkerLow(void * pArg);
+static void mutexWorkerHigh(void * pArg);
+static void mutexWorkerLow(void * pArg);
+static void mailboxWorkerHigh(void * pArg);
+static void mailboxWorkerLow(void * pArg);
+static void isrWorkerHigh(void * pArg);
+static void isrWorkerLow(void * pArg);
+static void controllerFunction(void * pArg);
+
+static const benchmark_t benchmarks[] =
+{
+	{ "yield_switch", yieldWorker, yieldWorker, 1 },
+	{ "semaphore_ping_pong", semaphoreWorkerHigh, semaphoreWorkerLow, 0 },
+	{ "mutex_handoff", mutexWorkerHigh, mutexWorkerLow, 0 },
+	{ "mailbox_round_trip", mailboxWorkerHigh, mailboxWorkerLow, 0 },
+	{ "isr_to_thread_wake", isrWorkerHigh, isrWorkerLow, 0 },
+};
+
+/**
+ * @brief Stores a sample, samples above BENCHMARK_ITERATIONS are dropped.
+ *
+ */
+static void addSample(uint32_t cycles)
+{
+	if(samplesNum < BENCHMARK_ITERATIONS)
+	{
+		samples[samplesNum++] = cycles;
+	}
+}
+
+/**
+ * @brief Gets the cycles since a timestamp, without the cost of the timestamps.
+ *
+ */
+static uint32_t elapsed(uint32_t start)
+{
+	uint32_t cycles = RTOS_SVC_getCycleCounter() - start;
+
+	return (cycles > timestampOverhead) ? (cycles - timestampOverhead) : 0;
+}
+
+static int compareSamples(const void * pFirst, const void * pSecond)
+{
+	uint32_t first = *(const uint32_t *) pFirst;
+	uint32_t second = *(const uint32_t *) pSecond;
+
+	return (first > second) - (first < second);
+}
+
+/**
+ * @brief Prints the statistics of the samples as one CSV line and clears them.
+ *
+ */
+static void report(const char * pName)
+{
+	uint64_t sum = 0;
+	uint32_t count = samplesNum;
+
+	if(count == 0)
+	{
+		printf("%s,0,0,0,0,0,0,0\n", pName);
+	}else
+	{
+		qsort(samples, count, sizeof(samples[0]), compareSamples);
+		for(uint32_t index = 0; index < count; index++)
+		{
+			sum += samples[index];
+		}
+
+		printf("%s,%u,%u,%u,%u,%u,%u,%u\n", pName, (unsigned int) count,
+				(unsigned int) samples[0], (unsigned int) (sum / count),
+				(unsigned int) samples[count - 1], (unsigned int) samples[(count * 50) / 100],
+				(unsigned int) samples[(count * 90) / 100], (unsigned int) samples[(count * 99) / 100]);
+	}
+
+	samplesNum = 0;
+}
+
+/**
+ * @brief Both workers yield to each other, each sample is one switch.
+ *
+ */
+static void yieldWorker(void * pArg)
+{
+	for(uint32_t index = 0; index < (BENCHMARK_ITERATIONS / 2); index++)
+	{
+		startStamp = RTOS_SVC_getCycleCounter();
+		RTOS_SVC_threadYield();
+		addSample(elapsed(startStamp));
+	}
+}
+
+static void semaphoreWorkerHigh(void * pArg)
+{
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		RTOS_SVC_semaphoreTake(&semaphores[1], WAIT_INDEFINITELY);
+		RTOS_SVC_semaphoreGive(&semaphores[0]);
+	}
+}
+
+/**
+ * @brief Each sample is a give to the high worker and the give back.
+ *
+ */
+static void semaphoreWorkerLow(void * pArg)
+{
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		uint32_t start = RTOS_SVC_getCycleCounter();
+		RTOS_SVC_semaphoreGive(&semaphores[1]);
+		RTOS_SVC_semaphoreTake(&semaphores[0], WAIT_INDEFINITELY);
+		addSample(elapsed(start));
+	}
+}
+
+/**
+ * @brief Each sample is from the release by the low worker to the lock
+ * returning in the waiting high worker.
+ *
+ */
+static void mutexWorkerHigh(void * pArg)
+{
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		RTOS_SVC_semaphoreTake(&semaphores[0], WAIT_INDEFINITELY);
+		RTOS_SVC_mutexLock(&mutex, WAIT_INDEFINITELY);
+		addSample(elapsed(startStamp));
+		RTOS_SVC_mutexRelease(&mutex);
+	}
+}
+
+static void mutexWorkerLow(void * pArg)
+{
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		RTOS_SVC_mutexLock(&mutex, WAIT_INDEFINITELY);
+
+		/* High worker runs and blocks on the mutex */
+		RTOS_SVC_semaphoreGive(&semaphores[0]);
+
+		startStamp = RTOS_SVC_getCycleCounter();
+		RTOS_SVC_mutexRelease(&mutex);
+	}
+}
+
+static void mailboxWorkerHigh(void * pArg)
+{
+	uint32_t message;
+
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		RTOS_SVC_mailboxRead(&mailboxes[0], WAIT_INDEFINITELY, &message);
+		RTOS_SVC_mailboxWrite(&mailboxes[1], WAIT_INDEFINITELY, &message);
+	}
+}
+
+/**
+ * @brief Each sample is a message to the high worker and its echo.
+ *
+ */
+static void mailboxWorkerLow(void * pArg)
+{
+	uint32_t message;
+
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		uint32_t start = RTOS_SVC_getCycleCounter();
+		message = index;
+		RTOS_SVC_mailboxWrite(&mailboxes[0], WAIT_INDEFINITELY, &message);
+		RTOS_SVC_mailboxRead(&mailboxes[1], WAIT_INDEFINITELY, &message);
+		addSample(elapsed(start));
+	}
+}
+
+/**
+ * @brief Each sample is from the interrupt handler entry to the first timestamp
+ * of the woken thread, including its timestamp SVC entry.
+ *
+ */
+static void isrWorkerHigh(void * pArg)
+{
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		RTOS_SVC_semaphoreTake(&semaphores[0], WAIT_INDEFINITELY);
+		addSample(RTOS_SVC_getCycleCounter() - isrStamp);
+	}
+}
+
+static void isrWorkerLow(void * pArg)
+{
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		/* Software trigger, allowed unprivileged with USERSETMPEND */
+		NVIC->STIR = BENCHMARK_IRQ;
+		__DSB();
+		__ISB();
+	}
+}
+
+/**
+ * @brief Benchmark interrupt handler, wakes up the high ISR worker.
+ *
+ */
+void EXTI0_IRQHandler(void)
+{
+	isrStamp = DWT->CYCCNT;
+	RTOS_semaphoreGiveFromISR(&semaphores[0]);
+}
+
+/**
+ * @brief Runs the benchmarks one after the other.
+ *
+ * The cost of back to back timestamps is measured first, reported as the SVC
+ * round trip and subtracted from the other results.
+ *
+ */
+static void controllerFunction(void * pArg)
+{
+	uint32_t start;
+
+	printf("benchmark,samples,min,mean,max,p50,p90,p99\n");
+
+	for(uint32_t index = 0; index < BENCHMARK_ITERATIONS; index++)
+	{
+		start = RTOS_SVC_getCycleCounter();
+		addSample(RTOS_SVC_getCycleCounter() - start);
+	}
+
+	/* Samples are sorted by the report */
+	timestampOverhead = 0;
+	report("svc_round_trip");
+	timestampOverhead = samples[0];
+
+	for(uint32_t index = 0; index < (sizeof(benchmarks) / sizeof(benchmarks[0])); index++)
+	{
+		RTOS_SVC_semaphoreCreate(&semaphores[0], 0);
+		RTOS_SVC_semaphoreCreate(&semaphores[1], 0);
+		RTOS_SVC_mutexCreate(&mutex, 1);
+		RTOS_SVC_mailboxCreate(&mailboxes[0], mailboxBuffers[0], sizeof(mailboxBuffers[0]), sizeof(uint32_t));
+		RTOS_SVC_mailboxCreate(&mailboxes[1], mailboxBuffers[1], sizeof(mailboxBuffers[1]), sizeof(uint32_t));
+
+		/* Both workers exist before either runs, the yield workers need a peer */
+		RTOS_SVC_schedulerLock();
+		RTOS_SVC_threadCreate(&workerThreads[0], &workerStacks[0],
+				(benchmarks[index].samePriority == 1) ? WORKER_PRIORITY_LOW : WORKER_PRIORITY_HIGH,
+				benchmarks[index].pWorkerHigh, NULL);
+		RTOS_SVC_threadCreate(&workerThreads[1], &workerStacks[1], WORKER_PRIORITY_LOW,
+				benchmarks[index].pWorkerLow, NULL);
+		RTOS_SVC_schedulerUnlock();
+
+		RTOS_SVC_threadJoin(&workerThreads[0], WAIT_INDEFINITELY);
+		RTOS_SVC_threadJoin(&workerThreads[1], WAIT_INDEFINITELY);
+
+		report(benchmarks[index].pName);
+	}
+
+	printf("benchmark,done\n");
+}
+
+/**
+ * @brief Starts the kernel with the benchmark controller thread, does not return.
+ *
+ * Must be called from main in privileged mode. Without a running cycle counter,
+ * e.g. on emulators that do not model the DWT, all results are 0.
+ *
+ */
+void benchmarkStart(void)
+{
+	uint32_t start;
+
+	RTOS_init();
+	consoleInit();
+
+	/* Threads trigger the benchmark interrupt through STIR */
+	SCB->CCR |= SCB_CCR_USERSETMPEND_Msk;
+	NVIC_SetPriority(BENCHMARK_IRQ, 2);
+	NVIC_EnableIRQ(BENCHMARK_IRQ);
+
+	/* Make sure the cycle counter runs */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	start = DWT->CYCCNT;
+	__NOP();
+	__NOP();
+	if(DWT->CYCCNT == start)
+	{
+		printf("# cycle counter is not running, results are 0\n");
+	}
+
+	RTOS_SVC_threadCreate(&controllerThread, &controllerStack, CONTROLLER_PRIORITY,
+			controllerFunction, NULL);
+	RTOS_SVC_schedulerStart();
+
+	while(1)
+	{
+
+	}
+}
+
+#endif /* BENCHMARK_ENABLE */
@@ -0,0 +1,25 @@
+/*
+ * benchmark.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+/**
+ * @brief Build with -DBENCHMARK_ENABLE=1 to run the kernel benchmarks
+ */
+#ifndef BENCHMARK_ENABLE
+#define BENCHMARK_ENABLE			0
+#endif
+
+/**
+ * @brief Samples measured by each benchmark
+ */
+#define BENCHMARK_ITERATIONS		((uint32_t) 1000u)
+
+void benchmarkStart(void);
+
+#endif /* BENCHMARK_H_ */
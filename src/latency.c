@@ -0,0 +1,271 @@
+/*
+ * latency.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+/*
+ * Interrupt latency and jitter harness.
+ *
+ * TIM2 fires its update interrupt after random periods, so the interrupt hits
+ * the kernel critical sections exercised by the load threads at random phases.
+ * The timer counter at handler entry gives the interrupt latency, it counts the
+ * timer ticks since the update event. The handler wakes the measurement thread,
+ * the switched in hook timestamps the thread when PendSV selects it, which gives
+ * the interrupt to thread latency. Both are kept in histograms and printed as CSV
+ * lines: name,bin start cycles,count.
+ */
+
+#include <stdio.h>
+#include "rtos.h"
+#include "uart_console.h"
+#include "latency.h"
+
+#if (LATENCY_ENABLE == 1)
+
+#if !defined(LATENCY_HOOKS_H_)
+#error "Build the latency harness with -DRTOS_HOOKS_HEADER=\"latency_hooks.h\""
+#endif
+
+#define MEASURE_PRIORITY			((uint32_t) 1u)
+#define LOAD_PRIORITY				((uint32_t) 4u)
+
+typedef struct
+{
+	const char * pName;
+	uint32_t binCycles;
+	uint32_t maxCycles;
+	uint32_t bins[LATENCY_HISTOGRAM_BINS];
+} histogram_t;
+
+static RTOS_thread_t measureThread;
+static RTOS_stack_t measureStack;
+static RTOS_thread_t loadThreads[2];
+static RTOS_stack_t loadStacks[2];
+
+static RTOS_semaphore_t wakeSemaphore;
+static RTOS_semaphore_t loadSemaphores[2];
+static RTOS_mutex_t loadMutex;
+
+static histogram_t irqHistogram = { "irq_latency", LATENCY_IRQ_BIN_CYCLES, 0, { 0 } };
+static histogram_t threadHistogram = { "irq_to_thread_latency", LATENCY_THREAD_BIN_CYCLES, 0, { 0 } };
+
+static volatile uint32_t eventCycle;
+static volatile uint32_t wakePending;
+static volatile uint32_t irqSamplesNum;
+static volatile uint32_t switchInCycle;
+static volatile uint32_t switchedIn;
+static uint32_t cyclesPerTimerTick;
+static uint32_t randomState = 0x2545F491u;
+
+static uint32_t nextPeriod(void);
+static void addSample(histogram_t * pHistogram, uint32_t cycles);
+static void report(histogram_t * pHistogram);
+static void measureFunction(void * pArg);
+static void loadFunction(void * pArg);
+
+/**
+ * @brief Gets the next random timer period, xorshift generator.
+ *
+ */
+static uint32_t nextPeriod(void)
+{
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+
+	return LATENCY_PERIOD_MIN + (randomState & (LATENCY_PERIOD_RANGE - 1));
+}
+
+static void addSample(histogram_t * pHistogram, uint32_t cycles)
+{
+	uint32_t bin = cycles / pHistogram->binCycles;
+
+	if(bin >= LATENCY_HISTOGRAM_BINS)
+	{
+		bin = LATENCY_HISTOGRAM_BINS - 1;
+	}
+
+	pHistogram->bins[bin]++;
+	if(cycles > pHistogram->maxCycles)
+	{
+		pHistogram->maxCycles = cycles;
+	}
+}
+
+/**
+ * @brief Prints the non-empty bins and the maximum of a histogram, then clears it.
+ *
+ */
+static void report(histogram_t * pHistogram)
+{
+	for(uint32_t bin = 0; bin < LATENCY_HISTOGRAM_BINS; bin++)
+	{
+		if(pHistogram->bins[bin] != 0)
+		{
+			printf("%s,%u,%u\n", pHistogram->pName, (unsigned int) (bin * pHistogram->binCycles),
+					(unsigned int) pHistogram->bins[bin]);
+		}
+		pHistogram->bins[bin] = 0;
+	}
+
+	printf("%s_max,%u\n", pHistogram->pName, (unsigned int) pHistogram->maxCycles);
+	pHistogram->maxCycles = 0;
+}
+
+/**
+ * @brief Harness timer interrupt handler.
+ *
+ */
+void TIM2_IRQHandler(void)
+{
+	/* Timer ticks since the update event, read first */
+	uint32_t timerTicks = TIM2->CNT;
+	uint32_t now = DWT->CYCCNT;
+	uint32_t latency = timerTicks * cyclesPerTimerTick;
+
+	TIM2->SR = (uint16_t) ~TIM_IT_Update;
+	TIM2->ARR = nextPeriod();
+
+	addSample(&irqHistogram, latency);
+	irqSamplesNum++;
+
+	if(wakePending == 0)
+	{
+		wakePending = 1;
+		eventCycle = now - latency;
+		RTOS_semaphoreGiveFromISR(&wakeSemaphore);
+	}
+}
+
+/**
+ * @brief Timestamps the first switch of the measurement thread after a wake up.
+ *
+ * Called by PendSV through RTOS_HOOK_THREAD_SWITCHED_IN, the latency ends when
+ * the thread is selected, before its context is restored.
+ *
+ */
+void latencyThreadSwitchedIn(RTOS_thread_t * pThread)
+{
+	if((pThread == &measureThread) && (wakePending == 1) && (switchedIn == 0))
+	{
+		switchInCycle = DWT->CYCCNT;
+		switchedIn = 1;
+	}
+}
+
+/**
+ * @brief Measures the interrupt to thread latency and prints the reports.
+ *
+ * Wake ups given while the thread still runs are not switches and are not sampled.
+ *
+ */
+static void measureFunction(void * pArg)
+{
+	uint32_t samplesNum = 0;
+
+	printf("name,cycles,count\n");
+
+	/* Timer peripheral is accessible unprivileged */
+	TIM_Cmd(TIM2, ENABLE);
+
+	while(1)
+	{
+		RTOS_SVC_semaphoreTake(&wakeSemaphore, WAIT_INDEFINITELY);
+		if(switchedIn == 1)
+		{
+			addSample(&threadHistogram, switchInCycle - eventCycle);
+			samplesNum++;
+		}
+		switchedIn = 0;
+		wakePending = 0;
+
+		if(samplesNum == LATENCY_SAMPLES)
+		{
+			TIM_Cmd(TIM2, DISABLE);
+			printf("irq_samples,%u\n", (unsigned int) irqSamplesNum);
+			report(&irqHistogram);
+			report(&threadHistogram);
+			irqSamplesNum = 0;
+			samplesNum = 0;
+			TIM_Cmd(TIM2, ENABLE);
+		}
+	}
+}
+
+/**
+ * @brief Keeps the kernel busy with semaphore, mutex and timer paths.
+ *
+ */
+static void loadFunction(void * pArg)
+{
+	uint32_t index = (uint32_t) pArg;
+
+	while(1)
+	{
+		RTOS_SVC_mutexLock(&loadMutex, WAIT_INDEFINITELY);
+		RTOS_SVC_semaphoreGive(&loadSemaphores[1 - index]);
+		RTOS_SVC_mutexRelease(&loadMutex);
+		RTOS_SVC_semaphoreTake(&loadSemaphores[index], 1);
+		RTOS_SVC_threadYield();
+	}
+}
+
+/**
+ * @brief Starts the kernel with the latency harness threads, does not return.
+ *
+ * Must be called from main in privileged mode.
+ *
+ */
+void latencyStart(void)
+{
+	TIM_TimeBaseInitTypeDef timeBase;
+	RCC_ClocksTypeDef clocks;
+
+	RTOS_init();
+	consoleInit();
+
+	/* Timer clock is twice PCLK1 when APB1 is divided */
+	RCC_GetClocksFreq(&clocks);
+	if(clocks.HCLK_Frequency == clocks.PCLK1_Frequency)
+	{
+		cyclesPerTimerTick = 1;
+	}else
+	{
+		cyclesPerTimerTick = clocks.HCLK_Frequency / (2 * clocks.PCLK1_Frequency);
+	}
+
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+	TIM_TimeBaseStructInit(&timeBase);
+	timeBase.TIM_Prescaler = 0;
+	timeBase.TIM_CounterMode = TIM_CounterMode_Up;
+	timeBase.TIM_Period = nextPeriod();
+	TIM_TimeBaseInit(TIM2, &timeBase);
+	TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+	TIM_ITConfig(TIM2, TIM_IT_Update, ENABLE);
+
+	NVIC_SetPriority(TIM2_IRQn, 2);
+	NVIC_EnableIRQ(TIM2_IRQn);
+
+	/* Make sure the cycle counter runs */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	RTOS_SVC_semaphoreCreate(&wakeSemaphore, 0);
+	RTOS_SVC_semaphoreCreate(&loadSemaphores[0], 0);
+	RTOS_SVC_semaphoreCreate(&loadSemaphores[1], 0);
+	RTOS_SVC_mutexCreate(&loadMutex, 1);
+
+	RTOS_SVC_threadCreate(&measureThread, &measureStack, MEASURE_PRIORITY, measureFunction, NULL);
+	RTOS_SVC_threadCreate(&loadThreads[0], &loadStacks[0], LOAD_PRIORITY, loadFunction, (void *) 0);
+	RTOS_SVC_threadCreate(&loadThreads[1], &loadStacks[1], LOAD_PRIORITY, loadFunction, (void *) 1);
+	RTOS_SVC_schedulerStart();
+
+	while(1)
+	{
+
+	}
+}
+
+#endif /* LATENCY_ENABLE */
@@ -0,0 +1,42 @@
+/*
+ * latency.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+/**
+ * @brief Build with -DLATENCY_ENABLE=1 to run the interrupt latency harness
+ */
+#ifndef LATENCY_ENABLE
+#define LATENCY_ENABLE			0
+#endif
+
+/**
+ * @brief Samples of each report
+ */
+#define LATENCY_SAMPLES				((uint32_t) 10000u)
+
+/**
+ * @brief Histogram bins, the last bin counts all larger latencies
+ */
+#define LATENCY_HISTOGRAM_BINS		((uint32_t) 64u)
+
+/**
+ * @brief Histogram bin widths in cycles
+ */
+#define LATENCY_IRQ_BIN_CYCLES		((uint32_t) 8u)
+#define LATENCY_THREAD_BIN_CYCLES	((uint32_t) 64u)
+
+/**
+ * @brief Range of the random timer periods in timer ticks
+ */
+#define LATENCY_PERIOD_MIN			((uint32_t) 2000u)
+#define LATENCY_PERIOD_RANGE		((uint32_t) 16384u)
+
+void latencyStart(void);
+
+#endif /* LATENCY_H_ */
@@ -0,0 +1,20 @@
+/*
+ * latency_hooks.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef LATENCY_HOOKS_H_
+#define LATENCY_HOOKS_H_
+
+/*
+ * Kernel hooks of the latency harness, build with LATENCY_ENABLE set to 1 and
+ * -DRTOS_HOOKS_HEADER=\"latency_hooks.h\".
+ */
+
+void latencyThreadSwitchedIn(RTOS_thread_t * pThread);
+
+#define RTOS_HOOK_THREAD_SWITCHED_IN(pThread)		latencyThreadSwitchedIn(pThread)
+
+#endif /* LATENCY_HOOKS_H_ */
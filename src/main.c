@@ -29,6 +29,8 @@ SOFTWARE.
 
 /* Includes */
 #include "stm32f4xx.h"
+#include "benchmark.h"
+#include "latency.h"
 
 /* Private macro */
 /* Private variables */
@@ -57,6 +59,11 @@ int main(void)
   */
 
   /* TODO - Add your application code here */
+#if (BENCHMARK_ENABLE == 1)
+  benchmarkStart();
+#elif (LATENCY_ENABLE == 1)
+  latencyStart();
+#endif
 
   /* Infinite loop */
   while (1)
@@ -0,0 +1,361 @@
+/*
+ * spi_bus.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+/*
+ * SPI5 bus service with a DMA transaction queue.
+ *
+ * Threads and interrupts push transfer descriptors onto a lock-free submit
+ * stack and pend the RX DMA interrupt. That interrupt owns the bus: it moves
+ * the submitted descriptors to its FIFO in submit order, runs them back to
+ * back with DMA, drives the chip selects and completes each descriptor with
+ * its callback or by waking the blocked caller. The TX DMA interrupt, at the
+ * same priority, only ends a transfer on a TX error. The CPU copies no data.
+ *
+ * SPI5 is wired to the L3GD20 gyroscope on the STM32F429I Discovery board,
+ * SCK on PF7, MISO on PF8 and MOSI on PF9. The bus runs in mode 3.
+ */
+
+#include "rtos.h"
+#include "spi_bus.h"
+
+#define SPI_BUS					SPI5
+#define TX_DMA_STREAM			DMA2_Stream4
+#define TX_DMA_IRQ				DMA2_Stream4_IRQn
+#define TX_DMA_FLAGS			(DMA_FLAG_TCIF4 | DMA_FLAG_HTIF4 | DMA_FLAG_TEIF4 \
+								| DMA_FLAG_DMEIF4 | DMA_FLAG_FEIF4)
+#define RX_DMA_STREAM			DMA2_Stream3
+#define RX_DMA_IRQ				DMA2_Stream3_IRQn
+#define RX_DMA_FLAGS			(DMA_FLAG_TCIF3 | DMA_FLAG_HTIF3 | DMA_FLAG_TEIF3 \
+								| DMA_FLAG_DMEIF3 | DMA_FLAG_FEIF3)
+
+static spiTransfer_t * volatile pSubmitted;		/* Submit stack, newest first */
+static spiTransfer_t * pQueueHead;				/* Bus owner FIFO, interrupt only */
+static spiTransfer_t * pQueueTail;
+static spiTransfer_t * pActive;					/* Running transfer, NULL when idle */
+
+static const uint8_t txDummy = 0xFF;
+static uint8_t rxDummy;
+
+static void collectSubmitted(void);
+static void startNext(void);
+static void complete(spiTransfer_t * pTransfer, uint32_t status);
+static void finishActive(uint32_t status);
+static void submit(spiTransfer_t * pTransfer);
+
+/**
+ * @brief Moves the submitted descriptors to the end of the FIFO, oldest first.
+ *
+ */
+static void collectSubmitted(void)
+{
+	spiTransfer_t * pStack;
+	spiTransfer_t * pReversed = NULL;
+	spiTransfer_t * pNext;
+
+	/* Take the whole submit stack */
+	do
+	{
+		pStack = (spiTransfer_t *) __LDREXW((volatile uint32_t *) &pSubmitted);
+	}while(__STREXW(0, (volatile uint32_t *) &pSubmitted) != 0);
+
+	while(pStack != NULL)
+	{
+		pNext = pStack->pNext;
+		pStack->pNext = pReversed;
+		pReversed = pStack;
+		pStack = pNext;
+	}
+
+	if(pReversed != NULL)
+	{
+		if(pQueueHead == NULL)
+		{
+			pQueueHead = pReversed;
+		}else
+		{
+			pQueueTail->pNext = pReversed;
+		}
+
+		pQueueTail = pReversed;
+		while(pQueueTail->pNext != NULL)
+		{
+			pQueueTail = pQueueTail->pNext;
+		}
+	}
+}
+
+/**
+ * @brief Starts the next queued transfer, if any.
+ *
+ */
+static void startNext(void)
+{
+	spiTransfer_t * pTransfer;
+
+	collectSubmitted();
+
+	pTransfer = pQueueHead;
+	if(pTransfer != NULL)
+	{
+		pQueueHead = pTransfer->pNext;
+		pActive = pTransfer;
+
+		/* Baud rate is only changed while the SPI is disabled */
+		if((SPI_BUS->CR1 & SPI_CR1_BR) != pTransfer->baudRatePrescaler)
+		{
+			SPI_Cmd(SPI_BUS, DISABLE);
+			SPI_BUS->CR1 = (SPI_BUS->CR1 & ~SPI_CR1_BR) | pTransfer->baudRatePrescaler;
+			SPI_Cmd(SPI_BUS, ENABLE);
+		}
+
+		DMA_ClearFlag(RX_DMA_STREAM, RX_DMA_FLAGS);
+		DMA_ClearFlag(TX_DMA_STREAM, TX_DMA_FLAGS);
+
+		if(pTransfer->pRxData != NULL)
+		{
+			RX_DMA_STREAM->M0AR = (uint32_t) pTransfer->pRxData;
+			RX_DMA_STREAM->CR |= DMA_SxCR_MINC;
+		}else
+		{
+			RX_DMA_STREAM->M0AR = (uint32_t) &rxDummy;
+			RX_DMA_STREAM->CR &= ~DMA_SxCR_MINC;
+		}
+
+		if(pTransfer->pTxData != NULL)
+		{
+			TX_DMA_STREAM->M0AR = (uint32_t) pTransfer->pTxData;
+			TX_DMA_STREAM->CR |= DMA_SxCR_MINC;
+		}else
+		{
+			TX_DMA_STREAM->M0AR = (uint32_t) &txDummy;
+			TX_DMA_STREAM->CR &= ~DMA_SxCR_MINC;
+		}
+
+		DMA_SetCurrDataCounter(RX_DMA_STREAM, pTransfer->length);
+		DMA_SetCurrDataCounter(TX_DMA_STREAM, pTransfer->length);
+
+		/* Select the chip, RX is armed before TX starts clocking */
+		pTransfer->pCsPort->BSRRH = pTransfer->csPin;
+		DMA_Cmd(RX_DMA_STREAM, ENABLE);
+		DMA_Cmd(TX_DMA_STREAM, ENABLE);
+	}
+}
+
+/**
+ * @brief Deselects the chip and completes a transfer.
+ *
+ */
+static void complete(spiTransfer_t * pTransfer, uint32_t status)
+{
+	pTransfer->pCsPort->BSRRL = pTransfer->csPin;
+	pTransfer->status = status;
+
+	if(pTransfer->pCallback != NULL)
+	{
+		pTransfer->pCallback(pTransfer);
+	}else
+	{
+		RTOS_semaphoreGiveFromISR(&pTransfer->doneSemaphore);
+	}
+}
+
+/**
+ * @brief Stops both streams, completes the running transfer and starts the next.
+ *
+ */
+static void finishActive(uint32_t status)
+{
+	/* Stop a stream still running after an error */
+	DMA_Cmd(TX_DMA_STREAM, DISABLE);
+	DMA_Cmd(RX_DMA_STREAM, DISABLE);
+	DMA_ClearFlag(RX_DMA_STREAM, RX_DMA_FLAGS);
+	DMA_ClearFlag(TX_DMA_STREAM, TX_DMA_FLAGS);
+
+	if(pActive != NULL)
+	{
+		complete(pActive, status);
+		pActive = NULL;
+	}
+
+	startNext();
+}
+
+/**
+ * @brief SPI RX DMA interrupt handler, also pended by submitters to start the queue.
+ *
+ * RX completes after the last byte is clocked, so its transfer complete ends the
+ * whole transfer.
+ *
+ */
+void DMA2_Stream3_IRQHandler(void)
+{
+	if(DMA_GetFlagStatus(RX_DMA_STREAM, DMA_FLAG_TEIF3) != RESET)
+	{
+		finishActive(SPI_TRANSFER_ERROR);
+	}else if(DMA_GetFlagStatus(RX_DMA_STREAM, DMA_FLAG_TCIF3) != RESET)
+	{
+		finishActive(SPI_TRANSFER_DONE);
+	}else if(pActive == NULL)
+	{
+		/* Pended by a submitter while the bus is idle */
+		startNext();
+	}else
+	{
+		/* Pended by a submitter, queued behind the running transfer */
+	}
+}
+
+/**
+ * @brief SPI TX DMA interrupt handler.
+ *
+ * A TX error stops the bus clock, so the RX transfer complete would never come.
+ *
+ */
+void DMA2_Stream4_IRQHandler(void)
+{
+	if(DMA_GetFlagStatus(TX_DMA_STREAM, DMA_FLAG_TEIF4) != RESET)
+	{
+		finishActive(SPI_TRANSFER_ERROR);
+	}
+}
+
+/**
+ * @brief Initializes SPI5 and its DMA streams.
+ *
+ * Must be called from main in privileged mode, after RTOS_init. Chip select
+ * pins are configured by the caller as push-pull outputs driven high.
+ *
+ */
+void spiBusInit(void)
+{
+	GPIO_InitTypeDef gpio;
+	SPI_InitTypeDef spi;
+	DMA_InitTypeDef dma;
+
+	pSubmitted = NULL;
+	pQueueHead = NULL;
+	pQueueTail = NULL;
+	pActive = NULL;
+
+	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOF | RCC_AHB1Periph_DMA2, ENABLE);
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_SPI5, ENABLE);
+
+	GPIO_PinAFConfig(GPIOF, GPIO_PinSource7, GPIO_AF_SPI5);
+	GPIO_PinAFConfig(GPIOF, GPIO_PinSource8, GPIO_AF_SPI5);
+	GPIO_PinAFConfig(GPIOF, GPIO_PinSource9, GPIO_AF_SPI5);
+	GPIO_StructInit(&gpio);
+	gpio.GPIO_Pin = GPIO_Pin_7 | GPIO_Pin_8 | GPIO_Pin_9;
+	gpio.GPIO_Mode = GPIO_Mode_AF;
+	gpio.GPIO_Speed = GPIO_Speed_50MHz;
+	gpio.GPIO_OType = GPIO_OType_PP;
+	gpio.GPIO_PuPd = GPIO_PuPd_NOPULL;
+	GPIO_Init(GPIOF, &gpio);
+
+	/* Master, 8 bits, mode 3, the baud rate is set for each transfer */
+	SPI_StructInit(&spi);
+	spi.SPI_Mode = SPI_Mode_Master;
+	spi.SPI_CPOL = SPI_CPOL_High;
+	spi.SPI_CPHA = SPI_CPHA_2Edge;
+	spi.SPI_NSS = SPI_NSS_Soft;
+	spi.SPI_BaudRatePrescaler = SPI_BaudRatePrescaler_256;
+	SPI_Init(SPI_BUS, &spi);
+
+	/* Memory address, increment and length are set for each transfer */
+	DMA_DeInit(TX_DMA_STREAM);
+	DMA_StructInit(&dma);
+	dma.DMA_Channel = DMA_Channel_2;
+	dma.DMA_PeripheralBaseAddr = (uint32_t) &SPI_BUS->DR;
+	dma.DMA_Memory0BaseAddr = (uint32_t) &txDummy;
+	dma.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+	dma.DMA_BufferSize = 1;
+	DMA_Init(TX_DMA_STREAM, &dma);
+	DMA_ITConfig(TX_DMA_STREAM, DMA_IT_TE, ENABLE);
+
+	DMA_DeInit(RX_DMA_STREAM);
+	dma.DMA_Memory0BaseAddr = (uint32_t) &rxDummy;
+	dma.DMA_DIR = DMA_DIR_PeripheralToMemory;
+	dma.DMA_Priority = DMA_Priority_High;
+	DMA_Init(RX_DMA_STREAM, &dma);
+	DMA_ITConfig(RX_DMA_STREAM, DMA_IT_TC | DMA_IT_TE, ENABLE);
+
+	SPI_I2S_DMACmd(SPI_BUS, SPI_I2S_DMAReq_Tx | SPI_I2S_DMAReq_Rx, ENABLE);
+	SPI_Cmd(SPI_BUS, ENABLE);
+
+	/* Same priority, the TX handler does not preempt the bus owner */
+	NVIC_SetPriority(RX_DMA_IRQ, SPI_BUS_IRQ_PRIORITY);
+	NVIC_SetPriority(TX_DMA_IRQ, SPI_BUS_IRQ_PRIORITY);
+	NVIC_EnableIRQ(RX_DMA_IRQ);
+	NVIC_EnableIRQ(TX_DMA_IRQ);
+
+	/* Submitters pend the RX DMA interrupt through STIR */
+	SCB->CCR |= SCB_CCR_USERSETMPEND_Msk;
+}
+
+/**
+ * @brief Pushes a transfer onto the submit stack and pends the bus owner.
+ *
+ */
+static void submit(spiTransfer_t * pTransfer)
+{
+	spiTransfer_t * pTop;
+
+	ASSERT(pTransfer->pCsPort != NULL);
+	ASSERT((pTransfer->length > 0) && (pTransfer->length <= SPI_BUS_MAX_LENGTH));
+	ASSERT((pTransfer->baudRatePrescaler & ~SPI_CR1_BR) == 0);
+
+	pTransfer->status = SPI_TRANSFER_PENDING;
+
+	/* Push onto the submit stack */
+	do
+	{
+		pTop = (spiTransfer_t *) __LDREXW((volatile uint32_t *) &pSubmitted);
+		pTransfer->pNext = pTop;
+	}while(__STREXW((uint32_t) pTransfer, (volatile uint32_t *) &pSubmitted) != 0);
+
+	/* Bus owner interrupt starts the transfer if the bus is idle */
+	NVIC->STIR = RX_DMA_IRQ;
+}
+
+/**
+ * @brief Queues a transfer without waiting, from threads or interrupts.
+ *
+ * The callback of the descriptor is called from the SPI DMA interrupt when the
+ * transfer is done, it can submit the next transfer. The descriptor and the
+ * buffers belong to the bus until then. Buffers must be DMA accessible, not in
+ * CCM RAM.
+ *
+ * @param[in,out] pTransfer Pointer to the transfer descriptor. Must not be NULL,
+ *                          its callback must not be NULL.
+ *
+ */
+void spiBusSubmit(spiTransfer_t * pTransfer)
+{
+	ASSERT(pTransfer != NULL);
+	ASSERT(pTransfer->pCallback != NULL);
+
+	submit(pTransfer);
+}
+
+/**
+ * @brief Runs a transfer and blocks the calling thread until it is done.
+ *
+ * @param[in,out] pTransfer Pointer to the transfer descriptor. Must not be NULL.
+ *
+ * @return SPI_TRANSFER_DONE, or SPI_TRANSFER_ERROR on a DMA error.
+ */
+uint32_t spiBusTransfer(spiTransfer_t * pTransfer)
+{
+	ASSERT(pTransfer != NULL);
+	ASSERT(RTOS_isSchedulerRunning() != 0);
+
+	pTransfer->pCallback = NULL;
+	RTOS_SVC_semaphoreCreate(&pTransfer->doneSemaphore, 0);
+	submit(pTransfer);
+	RTOS_SVC_semaphoreTake(&pTransfer->doneSemaphore, WAIT_INDEFINITELY);
+
+	return pTransfer->status;
+}
@@ -0,0 +1,51 @@
+/*
+ * spi_bus.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef SPI_BUS_H_
+#define SPI_BUS_H_
+
+/**
+ * @brief Priority of the SPI DMA interrupt, which runs the transaction queue
+ */
+#define SPI_BUS_IRQ_PRIORITY		((uint32_t) 4u)
+
+/**
+ * @brief Longest transfer in bytes, limited by the DMA data counter
+ */
+#define SPI_BUS_MAX_LENGTH			((uint32_t) 65535u)
+
+typedef enum
+{
+	SPI_TRANSFER_PENDING,
+	SPI_TRANSFER_DONE,
+	SPI_TRANSFER_ERROR
+} spiTransferStatus_t;
+
+struct spiTransfer_t;
+
+typedef void (*spiCallback_t)(struct spiTransfer_t * pTransfer);
+
+typedef struct spiTransfer_t
+{
+	GPIO_TypeDef * pCsPort;				/* Chip select port, the pin is driven low during the transfer */
+	uint16_t csPin;
+	uint16_t baudRatePrescaler;			/* SPI_BaudRatePrescaler_2 to SPI_BaudRatePrescaler_256 */
+	const void * pTxData;				/* Data to send, NULL to send 0xFF */
+	void * pRxData;						/* Received data, NULL to discard */
+	uint32_t length;					/* Transfer length in bytes */
+	spiCallback_t pCallback;			/* Called from the SPI DMA interrupt when done, set by spiBusTransfer */
+	void * pArg;						/* Free for the callback */
+	volatile uint32_t status;			/* spiTransferStatus_t */
+	RTOS_semaphore_t doneSemaphore;		/* Given when a blocking transfer is done */
+	struct spiTransfer_t * pNext;		/* Queue link */
+} spiTransfer_t;
+
+void spiBusInit(void);
+void spiBusSubmit(spiTransfer_t * pTransfer);
+uint32_t spiBusTransfer(spiTransfer_t * pTransfer);
+
+#endif /* SPI_BUS_H_ */
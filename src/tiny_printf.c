@@ -27,6 +27,12 @@ Abstract: Atollic TrueSTUDIO Minimal iprintf/siprintf/fiprintf
           Note:
           Character padding is not supported
 
+          The format is walked once into a TS_CHUNK_SIZE chunk on
+          the stack, flushed to the sink set by ts_init (_write by
+          default) whenever it fills. Once ts_init has created the
+          output lock, the chunks of one call from a thread are not
+          interleaved with other threads.
+
 The MIT License (MIT)
 Copyright (c) 2019 STMicroelectronics
 
@@ -55,6 +61,8 @@ SOFTWARE.
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
+#include "rtos.h"
+#include "tiny_printf.h"
 
 /* Create aliases for *printf to integer variants *iprintf */
 __attribute__ ((alias("iprintf"))) int printf(const char *fmt, ...);
@@ -64,10 +72,31 @@ __attribute__ ((alias("siprintf"))) int sprintf(char* str, const char *fmt, ...)
 /* External function prototypes (defined in syscalls.c) */
 extern int _write(int fd, char *str, int len);
 
+/* Private typedefs */
+typedef struct
+{
+	char *str;					/* Destination of siprintf, NULL to flush to the sink */
+	int fd;
+	int written;				/* Characters written so far */
+	int used;					/* Characters waiting in the chunk */
+	int locked;					/* 1 while the output lock is held */
+	char chunk[TS_CHUNK_SIZE];
+} ts_output_t;
+
+/* Private variables */
+static ts_sink_t ts_sink = _write;
+static RTOS_mutex_t ts_mutex;
+static volatile int ts_mutexcreated = 0;
+
 /* Private function prototypes */
 void ts_itoa(char **buf, unsigned int d, int base);
-int ts_formatstring(char *buf, const char *fmt, va_list va);
-int ts_formatlength(const char *fmt, va_list va);
+static void ts_format(ts_output_t *out, const char *fmt, va_list va);
+static int ts_write(int fd, const char *s, int len, int newline);
+static void ts_lock(ts_output_t *out);
+static void ts_unlock(ts_output_t *out);
+static void ts_flush(ts_output_t *out);
+static void ts_putc(ts_output_t *out, char c);
+static void ts_puts(ts_output_t *out, const char *s);
 
 /* Private functions */
 
@@ -79,8 +108,8 @@ int ts_formatlength(const char *fmt, va_list va);
 */
 void ts_itoa(char **buf, unsigned int d, int base)
 {
-	int div = 1;
-	while (d/div >= base)
+	unsigned int div = 1;
+	while (d/div >= (unsigned int)base)
 		div *= base;
 
 	while (div != 0)
@@ -97,22 +126,113 @@ void ts_itoa(char **buf, unsigned int d, int base)
 
 /**
 **---------------------------------------------------------------------------
-**  Abstract: Writes arguments va to buffer buf according to format fmt
-**  Returns:  Length of string
+**  Abstract: Takes the output lock, only threads of a running scheduler
+**            take it, interrupts and startup code write unlocked
+**  Returns:  void
+**---------------------------------------------------------------------------
+*/
+static void ts_lock(ts_output_t *out)
+{
+	if ((out->locked == 0) && (ts_mutexcreated != 0)
+			&& (__get_IPSR() == 0) && (RTOS_isSchedulerRunning() != 0))
+	{
+		RTOS_SVC_mutexLock(&ts_mutex, WAIT_INDEFINITELY);
+		out->locked = 1;
+	}
+}
+
+/**
+**---------------------------------------------------------------------------
+**  Abstract: Releases the output lock if held
+**  Returns:  void
+**---------------------------------------------------------------------------
+*/
+static void ts_unlock(ts_output_t *out)
+{
+	if (out->locked != 0)
+	{
+		RTOS_SVC_mutexRelease(&ts_mutex);
+		out->locked = 0;
+	}
+}
+
+/**
+**---------------------------------------------------------------------------
+**  Abstract: Writes the chunk to the sink, the lock is kept until the end
+**            of the call so the chunks of one call are not interleaved
+**  Returns:  void
+**---------------------------------------------------------------------------
+*/
+static void ts_flush(ts_output_t *out)
+{
+	int length;
+
+	if (out->used > 0)
+	{
+		ts_lock(out);
+		length = ts_sink(out->fd, out->chunk, out->used);
+		if (length > 0)
+			out->written += length;
+		out->used = 0;
+	}
+}
+
+/**
+**---------------------------------------------------------------------------
+**  Abstract: Outputs one character, to the siprintf string or to the chunk
+**  Returns:  void
+**---------------------------------------------------------------------------
+*/
+static void ts_putc(ts_output_t *out, char c)
+{
+	if (out->str != NULL)
+	{
+		out->str[out->written++] = c;
+	}
+	else
+	{
+		if (out->used == TS_CHUNK_SIZE)
+			ts_flush(out);
+		out->chunk[out->used++] = c;
+	}
+}
+
+/**
+**---------------------------------------------------------------------------
+**  Abstract: Outputs a string without the trailing null
+**  Returns:  void
+**---------------------------------------------------------------------------
+*/
+static void ts_puts(ts_output_t *out, const char *s)
+{
+	while (*s)
+		ts_putc(out, *s++);
+}
+
+/**
+**---------------------------------------------------------------------------
+**  Abstract: Writes arguments va to out according to format fmt in a
+**            single pass
+**  Returns:  void
 **---------------------------------------------------------------------------
 */
-int ts_formatstring(char *buf, const char *fmt, va_list va)
+static void ts_format(ts_output_t *out, const char *fmt, va_list va)
 {
-	char *start_buf = buf;
+	/* 32 bits integer is max 10 digits */
+	char digits[10];
+	char *digit;
+	char *end;
+
 	while(*fmt)
 	{
 		/* Character needs formating? */
 		if (*fmt == '%')
 		{
+			end = digits;
 			switch (*(++fmt))
 			{
 			  case 'c':
-				*buf++ = va_arg(va, int);
+				ts_putc(out, (char)va_arg(va, int));
 				break;
 			  case 'd':
 			  case 'i':
@@ -120,99 +240,109 @@ int ts_formatstring(char *buf, const char *fmt, va_list va)
 					signed int val = va_arg(va, signed int);
 					if (val < 0)
 					{
-						val *= -1;
-						*buf++ = '-';
+						ts_putc(out, '-');
 					}
-					ts_itoa(&buf, val, 10);
+					ts_itoa(&end, (val < 0) ? (0u - (unsigned int)val) : (unsigned int)val, 10);
 				}
 				break;
 			  case 's':
-				{
-					char * arg = va_arg(va, char *);
-					while (*arg)
-					{
-						*buf++ = *arg++;
-					}
-				}
+				ts_puts(out, va_arg(va, char *));
 				break;
 			  case 'u':
-					ts_itoa(&buf, va_arg(va, unsigned int), 10);
+				ts_itoa(&end, va_arg(va, unsigned int), 10);
 				break;
 			  case 'x':
 			  case 'X':
-					ts_itoa(&buf, va_arg(va, int), 16);
+				ts_itoa(&end, va_arg(va, unsigned int), 16);
 				break;
 			  case '%':
-				  *buf++ = '%';
-				  break;
+				ts_putc(out, '%');
+				break;
+			  case '\0':
+				/* Format ends with a lone % */
+				fmt--;
+				break;
+			}
+			for (digit = digits; digit < end; digit++)
+			{
+				ts_putc(out, *digit);
 			}
 			fmt++;
 		}
 		/* Else just copy */
 		else
 		{
-			*buf++ = *fmt++;
+			ts_putc(out, *fmt++);
 		}
 	}
-	*buf = 0;
-
-	return (int)(buf - start_buf);
 }
 
+/**
+**---------------------------------------------------------------------------
+**  Abstract: Formats to a file descriptor through the sink
+**  Returns:  Number of bytes written
+**---------------------------------------------------------------------------
+*/
+static int ts_vfdprintf(int fd, const char *fmt, va_list va)
+{
+	ts_output_t out;
+
+	out.str = NULL;
+	out.fd = fd;
+	out.written = 0;
+	out.used = 0;
+	out.locked = 0;
+
+	ts_format(&out, fmt, va);
+	ts_flush(&out);
+	ts_unlock(&out);
+
+	return out.written;
+}
 
 /**
 **---------------------------------------------------------------------------
-**  Abstract: Calculate maximum length of the resulting string from the
-**            format string and va_list va
-**  Returns:  Maximum length
+**  Abstract: Writes len characters, and a newline if requested, to a file
+**            descriptor through the sink under one lock
+**  Returns:  Number of bytes written
 **---------------------------------------------------------------------------
 */
-int ts_formatlength(const char *fmt, va_list va)
+static int ts_write(int fd, const char *s, int len, int newline)
+{
+	ts_output_t out;
+
+	out.str = NULL;
+	out.fd = fd;
+	out.written = 0;
+	out.used = 0;
+	out.locked = 0;
+
+	while (len-- > 0)
+		ts_putc(&out, *s++);
+	if (newline)
+		ts_putc(&out, '\n');
+	ts_flush(&out);
+	ts_unlock(&out);
+
+	return out.written;
+}
+
+/**
+**===========================================================================
+**  Abstract: Sets the output sink and creates the output lock. Call after
+**            RTOS_init and before the scheduler starts, a NULL sink keeps
+**            _write. Without this call the output is not serialised.
+**  Returns:  void
+**===========================================================================
+*/
+void ts_init(ts_sink_t sink)
 {
-	int length = 0;
-	while (*fmt)
+	ts_sink = (sink != NULL) ? sink : _write;
+	if (ts_mutexcreated == 0)
 	{
-		if (*fmt == '%')
-		{
-			++fmt;
-			switch (*fmt)
-			{
-			  case 'c':
-		  		  va_arg(va, int);
-				  ++length;
-				  break;
-			  case 'd':
-			  case 'i':
-			  case 'u':
-				  /* 32 bits integer is max 11 characters with minus sign */
-				  length += 11;
-				  va_arg(va, int);
-				  break;
-			  case 's':
-			  	  {
-			  		  char * str = va_arg(va, char *);
-			  		  while (*str++)
-			  			  ++length;
-			  	  }
-				  break;
-			  case 'x':
-			  case 'X':
-				  /* 32 bits integer as hex is max 8 characters */
-				  length += 8;
-				  va_arg(va, unsigned int);
-				  break;
-			  default:
-				  ++length;
-				  break;
-			}
-		}
-		else
-		{
-			++length;
-		}
-		++fmt;
+		RTOS_mutexCreate(&ts_mutex, 1);
+		ts_mutexcreated = 1;
 	}
-	return length;
 }
 
 /**
@@ -224,12 +354,20 @@ int ts_formatlength(const char *fmt, va_list va)
 */
 int siprintf(char *buf, const char *fmt, ...)
 {
-	int length;
+	ts_output_t out;
 	va_list va;
+
+	out.str = buf;
+	out.fd = 0;
+	out.written = 0;
+	out.used = 0;
+	out.locked = 0;
+
 	va_start(va, fmt);
-	length = ts_formatstring(buf, fmt, va);
+	ts_format(&out, fmt, va);
 	va_end(va);
-	return length;
+	buf[out.written] = 0;
+	return out.written;
 }
 
 /**
@@ -241,18 +379,11 @@ int siprintf(char *buf, const char *fmt, ...)
 */
 int fiprintf(FILE * stream, const char *fmt, ...)
 {
-	int length = 0;
+	int length;
 	va_list va;
 	va_start(va, fmt);
-	length = ts_formatlength(fmt, va);
+	length = ts_vfdprintf(stream->_file, fmt, va);
 	va_end(va);
-	{
-		char buf[length];
-		va_start(va, fmt);
-		length = ts_formatstring(buf, fmt, va);
-		length = _write(stream->_file, buf, length);
-		va_end(va);
-	}
 	return length;
 }
 
@@ -266,18 +397,11 @@ int fiprintf(FILE * stream, const char *fmt, ...)
 */
 int iprintf(const char *fmt, ...)
 {
-	int length = 0;
+	int length;
 	va_list va;
 	va_start(va, fmt);
-	length = ts_formatlength(fmt, va);
+	length = ts_vfdprintf(1, fmt, va);
 	va_end(va);
-	{
-		char buf[length];
-		va_start(va, fmt);
-		length = ts_formatstring(buf, fmt, va);
-		length = _write(1, buf, length);
-		va_end(va);
-	}
 	return length;
 }
 
@@ -292,13 +416,9 @@ int iprintf(const char *fmt, ...)
 int fputs(const char *s, FILE *fp)
 {
 	int length = strlen(s);
-	int wlen = 0;
 	int res;
 
-	wlen = _write((fp->_file), (char*)s, length);
-	wlen += _write((fp->_file), "\n", 1);
-
-	if (wlen == (length+1))
+	if (ts_write(fp->_file, s, length, 1) == (length+1))
 	{
 		res = 0;
 	}
@@ -322,13 +442,9 @@ int fputs(const char *s, FILE *fp)
 int puts(const char *s)
 {
 	int length = strlen(s);
-	int numbytes = 0;
 	int res;
 
-	numbytes = _write(1, (char*)s, length);
-	numbytes += _write(1, "\n", 1);
-
-	if (numbytes == (length+1))
+	if (ts_write(1, s, length, 1) == (length+1))
 	{
 		res = 0;
 	}
@@ -350,5 +466,5 @@ int puts(const char *s)
 */
 size_t fwrite(const void * buf, size_t size, size_t count, FILE * fp)
 {
-	return (_write((fp->_file), (char*)buf, size * count) / size);
+	return (ts_write(fp->_file, buf, size * count, 0) / size);
 }
@@ -0,0 +1,26 @@
+/*
+ * tiny_printf.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef TINY_PRINTF_H_
+#define TINY_PRINTF_H_
+
+/**
+ * @brief Characters formatted on the stack before each flush to the sink
+ */
+#ifndef TS_CHUNK_SIZE
+#define TS_CHUNK_SIZE		64
+#endif
+
+/**
+ * @brief Output sink, called with one chunk at a time. Returns the number of
+ * characters written, same as _write.
+ */
+typedef int (*ts_sink_t)(int fd, char *str, int len);
+
+void ts_init(ts_sink_t sink);
+
+#endif /* TINY_PRINTF_H_ */
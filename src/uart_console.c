@@ -0,0 +1,390 @@
+/*
+ * uart_console.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+/*
+ * DMA driven USART1 console.
+ *
+ * TX: writers copy into a ring buffer and pend the TX DMA interrupt, which is
+ * the only place a transfer is started. Each completed transfer consumes its
+ * span, chains the next one and wakes a writer waiting for space.
+ * RX: DMA fills a circular buffer, the half transfer, transfer complete and
+ * idle line interrupts move the new bytes into a kernel stream buffer.
+ */
+
+#include "rtos.h"
+#include "tiny_printf.h"
+#include "uart_console.h"
+
+#define TX_DMA_STREAM			DMA2_Stream7
+#define TX_DMA_IRQ				DMA2_Stream7_IRQn
+#define TX_DMA_FLAGS			(DMA_FLAG_TCIF7 | DMA_FLAG_HTIF7 | DMA_FLAG_TEIF7 \
+								| DMA_FLAG_DMEIF7 | DMA_FLAG_FEIF7)
+#define RX_DMA_STREAM			DMA2_Stream2
+#define RX_DMA_IRQ				DMA2_Stream2_IRQn
+#define RX_DMA_FLAGS			(DMA_FLAG_TCIF2 | DMA_FLAG_HTIF2 | DMA_FLAG_TEIF2 \
+								| DMA_FLAG_DMEIF2 | DMA_FLAG_FEIF2)
+
+static uint8_t txBuffer[CONSOLE_TX_BUFFER_SIZE];
+static uint8_t rxDmaBuffer[CONSOLE_RX_DMA_SIZE];
+static uint8_t rxBuffer[CONSOLE_RX_BUFFER_SIZE];
+
+static RTOS_ringBuffer_t txRing;
+static RTOS_mutex_t txMutex;
+static RTOS_semaphore_t txSpaceSemaphore;
+static RTOS_streamBuffer_t rxStream;
+
+static volatile uint32_t txLength;			/* Length of the running transfer, 0 when idle */
+static volatile uint32_t txWaiting;			/* 1 while a writer waits for free space */
+static uint32_t rxPosition;					/* Next RX DMA buffer index to deliver */
+static volatile uint32_t droppedLength;
+
+static void addDropped(uint32_t length);
+static void txStart(void);
+static void rxDeliver(const uint8_t * pData, uint32_t length);
+static void rxProcess(void);
+
+/**
+ * @brief Counts dropped bytes, from threads and interrupts.
+ *
+ */
+static void addDropped(uint32_t length)
+{
+	uint32_t dropped;
+
+	do
+	{
+		dropped = __LDREXW(&droppedLength);
+	}while(__STREXW(dropped + length, &droppedLength) != 0);
+}
+
+/**
+ * @brief Starts a DMA transfer of the oldest TX ring data, if any.
+ *
+ * Only called from the TX DMA interrupt, so no transfer is started twice.
+ *
+ */
+static void txStart(void)
+{
+	uint8_t * pSpan;
+	uint32_t length = RTOS_ringBufferGetReadSpan(&txRing, &pSpan);
+
+	if(length > 0)
+	{
+		if(length > CONSOLE_TX_DMA_MAX)
+		{
+			length = CONSOLE_TX_DMA_MAX;
+		}
+
+		txLength = length;
+		DMA_ClearFlag(TX_DMA_STREAM, TX_DMA_FLAGS);
+		TX_DMA_STREAM->M0AR = (uint32_t) pSpan;
+		DMA_SetCurrDataCounter(TX_DMA_STREAM, length);
+		DMA_Cmd(TX_DMA_STREAM, ENABLE);
+	}
+}
+
+/**
+ * @brief Delivers received bytes to the RX stream buffer.
+ *
+ */
+static void rxDeliver(const uint8_t * pData, uint32_t length)
+{
+	uint32_t sentLength = RTOS_streamBufferSendFromISR(&rxStream, pData, length);
+
+	if(sentLength < length)
+	{
+		addDropped(length - sentLength);
+	}
+}
+
+/**
+ * @brief Delivers the bytes written by the RX DMA since the last call.
+ *
+ * Called from the RX DMA and the USART interrupts, both at the same priority.
+ *
+ */
+static void rxProcess(void)
+{
+	uint32_t position = CONSOLE_RX_DMA_SIZE - DMA_GetCurrDataCounter(RX_DMA_STREAM);
+
+	if(position == CONSOLE_RX_DMA_SIZE)
+	{
+		position = 0;
+	}
+
+	if(position > rxPosition)
+	{
+		rxDeliver(&rxDmaBuffer[rxPosition], position - rxPosition);
+	}else if(position < rxPosition)
+	{
+		/* Data wrapped around the end of the circular buffer */
+		rxDeliver(&rxDmaBuffer[rxPosition], CONSOLE_RX_DMA_SIZE - rxPosition);
+		if(position > 0)
+		{
+			rxDeliver(rxDmaBuffer, position);
+		}
+	}else
+	{
+		/* No new data */
+	}
+
+	rxPosition = position;
+}
+
+/**
+ * @brief TX DMA interrupt handler, also pended by writers to start a transfer.
+ *
+ */
+void DMA2_Stream7_IRQHandler(void)
+{
+	if((DMA_GetFlagStatus(TX_DMA_STREAM, DMA_FLAG_TCIF7) != RESET)
+			|| (DMA_GetFlagStatus(TX_DMA_STREAM, DMA_FLAG_TEIF7) != RESET))
+	{
+		/* Stream is disabled by hardware, a failed transfer is dropped too */
+		DMA_ClearFlag(TX_DMA_STREAM, TX_DMA_FLAGS);
+		RTOS_ringBufferConsume(&txRing, txLength);
+		txLength = 0;
+
+		if(txWaiting == 1)
+		{
+			txWaiting = 0;
+			RTOS_semaphoreGiveFromISR(&txSpaceSemaphore);
+		}
+	}
+
+	if(txLength == 0)
+	{
+		txStart();
+	}
+}
+
+/**
+ * @brief RX DMA interrupt handler, at half and full circular buffer.
+ *
+ */
+void DMA2_Stream2_IRQHandler(void)
+{
+	DMA_ClearFlag(RX_DMA_STREAM, RX_DMA_FLAGS);
+	rxProcess();
+}
+
+/**
+ * @brief USART1 interrupt handler, at idle line after a received frame.
+ *
+ */
+void USART1_IRQHandler(void)
+{
+	if(USART_GetITStatus(USART1, USART_IT_IDLE) != RESET)
+	{
+		/* Idle flag is cleared by reading SR then DR */
+		(void) USART_ReceiveData(USART1);
+		rxProcess();
+	}
+}
+
+/**
+ * @brief Initializes USART1, its DMA streams and the console buffers, and routes
+ * printf to the console.
+ *
+ * Must be called from main in privileged mode, after RTOS_init and before the
+ * scheduler starts.
+ *
+ */
+void consoleInit(void)
+{
+	GPIO_InitTypeDef gpio;
+	USART_InitTypeDef usart;
+	DMA_InitTypeDef dma;
+
+	RTOS_ringBufferCreate(&txRing, txBuffer, CONSOLE_TX_BUFFER_SIZE, NULL, 0);
+	RTOS_mutexCreate(&txMutex, 1);
+	RTOS_semaphoreCreate(&txSpaceSemaphore, 0);
+	RTOS_streamBufferCreate(&rxStream, rxBuffer, CONSOLE_RX_BUFFER_SIZE, 1);
+	txLength = 0;
+	txWaiting = 0;
+	rxPosition = 0;
+	droppedLength = 0;
+
+	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOA | RCC_AHB1Periph_DMA2, ENABLE);
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1, ENABLE);
+
+	GPIO_PinAFConfig(GPIOA, GPIO_PinSource9, GPIO_AF_USART1);
+	GPIO_PinAFConfig(GPIOA, GPIO_PinSource10, GPIO_AF_USART1);
+	GPIO_StructInit(&gpio);
+	gpio.GPIO_Pin = GPIO_Pin_9 | GPIO_Pin_10;
+	gpio.GPIO_Mode = GPIO_Mode_AF;
+	gpio.GPIO_Speed = GPIO_Speed_50MHz;
+	gpio.GPIO_OType = GPIO_OType_PP;
+	gpio.GPIO_PuPd = GPIO_PuPd_UP;
+	GPIO_Init(GPIOA, &gpio);
+
+	/* 8N1, no flow control */
+	USART_StructInit(&usart);
+	usart.USART_BaudRate = CONSOLE_BAUD_RATE;
+	USART_Init(USART1, &usart);
+
+	/* TX stream, the memory address and length are set for each transfer */
+	DMA_DeInit(TX_DMA_STREAM);
+	DMA_StructInit(&dma);
+	dma.DMA_Channel = DMA_Channel_4;
+	dma.DMA_PeripheralBaseAddr = (uint32_t) &USART1->DR;
+	dma.DMA_Memory0BaseAddr = (uint32_t) txBuffer;
+	dma.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+	dma.DMA_BufferSize = 1;
+	dma.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_Init(TX_DMA_STREAM, &dma);
+	DMA_ITConfig(TX_DMA_STREAM, DMA_IT_TC | DMA_IT_TE, ENABLE);
+
+	/* RX stream runs forever in circular mode */
+	DMA_DeInit(RX_DMA_STREAM);
+	dma.DMA_Memory0BaseAddr = (uint32_t) rxDmaBuffer;
+	dma.DMA_DIR = DMA_DIR_PeripheralToMemory;
+	dma.DMA_BufferSize = CONSOLE_RX_DMA_SIZE;
+	dma.DMA_Mode = DMA_Mode_Circular;
+	DMA_Init(RX_DMA_STREAM, &dma);
+	DMA_ITConfig(RX_DMA_STREAM, DMA_IT_HT | DMA_IT_TC, ENABLE);
+	DMA_Cmd(RX_DMA_STREAM, ENABLE);
+
+	USART_ClearFlag(USART1, USART_FLAG_TC);
+	USART_DMACmd(USART1, USART_DMAReq_Tx | USART_DMAReq_Rx, ENABLE);
+	USART_ITConfig(USART1, USART_IT_IDLE, ENABLE);
+	USART_Cmd(USART1, ENABLE);
+
+	NVIC_SetPriority(TX_DMA_IRQ, CONSOLE_IRQ_PRIORITY);
+	NVIC_SetPriority(RX_DMA_IRQ, CONSOLE_IRQ_PRIORITY);
+	NVIC_SetPriority(USART1_IRQn, CONSOLE_IRQ_PRIORITY);
+	NVIC_EnableIRQ(TX_DMA_IRQ);
+	NVIC_EnableIRQ(RX_DMA_IRQ);
+	NVIC_EnableIRQ(USART1_IRQn);
+
+	/* Writers pend the TX DMA interrupt through STIR */
+	SCB->CCR |= SCB_CCR_USERSETMPEND_Msk;
+
+	ts_init(consoleSink);
+}
+
+/**
+ * @brief Writes data to the console, with optional blocking until it fits.
+ *
+ * The data is copied into the TX ring buffer and sent by DMA in the background.
+ * Writers are serialized by a mutex. Before the scheduler starts, the call never
+ * blocks. Interrupt handlers cannot write, their data is dropped, RTOS_LOG is
+ * meant for them.
+ *
+ * @param[in] pData    Pointer to the data. Must not be NULL.
+ * @param[in] length   Length of the data in bytes.
+ * @param[in] waitTime Total wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ *
+ * @return Number of bytes written, the rest is dropped.
+ */
+uint32_t consoleWrite(const void * pData, uint32_t length, int32_t waitTime)
+{
+	const uint8_t * pSource = (const uint8_t *) pData;
+	uint32_t deadline = RTOS_threadGetTickCount() + (uint32_t) waitTime;
+	uint32_t writtenLength = 0;
+	uint32_t canWrite = 0;
+	uint32_t locked = 0;
+	uint32_t terminate = 0;
+	int32_t remainingTime = waitTime;
+
+	ASSERT(pData != NULL);
+	ASSERT(waitTime >= WAIT_INDEFINITELY);
+
+	if(__get_IPSR() != 0)
+	{
+		/* The ring has a single producer, an interrupt could corrupt a thread write */
+	}else if(RTOS_isSchedulerRunning() == 0)
+	{
+		/* Startup code runs alone and cannot block */
+		remainingTime = NO_WAIT;
+		canWrite = 1;
+	}else if(RTOS_SVC_mutexLock(&txMutex, waitTime) != RTOS_FAILURE)
+	{
+		locked = 1;
+		canWrite = 1;
+	}else
+	{
+		/* Timed out waiting for the other writers */
+	}
+
+	while((canWrite == 1) && (terminate == 0))
+	{
+		/* Set first, so space freed during the write still wakes the writer */
+		txWaiting = 1;
+		__DMB();
+		writtenLength += RTOS_ringBufferWrite(&txRing, &pSource[writtenLength], length - writtenLength);
+
+		/* Start the transfer from the TX DMA interrupt */
+		NVIC->STIR = TX_DMA_IRQ;
+
+		if((writtenLength == length) || (remainingTime == NO_WAIT))
+		{
+			terminate = 1;
+		}else if(remainingTime != WAIT_INDEFINITELY)
+		{
+			remainingTime = (int32_t) (deadline - RTOS_threadGetTickCount());
+			terminate = (remainingTime <= 0) ? 1 : 0;
+		}else
+		{
+			/* Wait indefinitely */
+		}
+
+		if(terminate == 0)
+		{
+			RTOS_SVC_semaphoreTake(&txSpaceSemaphore, remainingTime);
+		}
+	}
+	txWaiting = 0;
+
+	if(locked == 1)
+	{
+		RTOS_SVC_mutexRelease(&txMutex);
+	}
+
+	if(writtenLength < length)
+	{
+		addDropped(length - writtenLength);
+	}
+
+	return writtenLength;
+}
+
+/**
+ * @brief Reads received data from the console, with optional blocking until
+ * data is available.
+ *
+ * @param[out] pData    Pointer to the destination. Must not be NULL.
+ * @param[in]  length   Length of the destination in bytes.
+ * @param[in]  waitTime Wait time in ticks, NO_WAIT or WAIT_INDEFINITELY.
+ *
+ * @return Number of bytes read, 0 if the wait time expired.
+ */
+uint32_t consoleRead(void * pData, uint32_t length, int32_t waitTime)
+{
+	ASSERT(pData != NULL);
+
+	return RTOS_SVC_streamBufferReceive(&rxStream, waitTime, pData, length);
+}
+
+/**
+ * @brief tiny_printf sink, enqueues without blocking and drops what does not fit.
+ *
+ */
+int consoleSink(int fd, char * str, int len)
+{
+	return (int) consoleWrite(str, (uint32_t) len, NO_WAIT);
+}
+
+/**
+ * @brief Gets the number of TX and RX bytes dropped because a buffer was full.
+ *
+ * @return Dropped bytes since consoleInit.
+ */
+uint32_t consoleGetDropped(void)
+{
+	return droppedLength;
+}
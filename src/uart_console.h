@@ -0,0 +1,47 @@
+/*
+ * uart_console.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: halaabdelrahman
+ */
+
+#ifndef UART_CONSOLE_H_
+#define UART_CONSOLE_H_
+
+/**
+ * @brief USART1 baud rate, TX on PA9 and RX on PA10
+ */
+#define CONSOLE_BAUD_RATE			((uint32_t) 115200u)
+
+/**
+ * @brief TX ring buffer size in bytes, must be a power of two
+ */
+#define CONSOLE_TX_BUFFER_SIZE		((uint32_t) 1024u)
+
+/**
+ * @brief Longest TX DMA transfer in bytes, waiting writers are woken after each one
+ */
+#define CONSOLE_TX_DMA_MAX			((uint32_t) 64u)
+
+/**
+ * @brief RX DMA circular buffer size in bytes, drained at half, full and idle line
+ */
+#define CONSOLE_RX_DMA_SIZE			((uint32_t) 64u)
+
+/**
+ * @brief RX stream buffer size in bytes
+ */
+#define CONSOLE_RX_BUFFER_SIZE		((uint32_t) 256u)
+
+/**
+ * @brief Priority of the USART and DMA interrupts
+ */
+#define CONSOLE_IRQ_PRIORITY		((uint32_t) 5u)
+
+void consoleInit(void);
+uint32_t consoleWrite(const void * pData, uint32_t length, int32_t waitTime);
+uint32_t consoleRead(void * pData, uint32_t length, int32_t waitTime);
+int consoleSink(int fd, char * str, int len);
+uint32_t consoleGetDropped(void);
+
+#endif /* UART_CONSOLE_H_ */
@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""
+Decodes a TimeOS deferred log buffer RAM dump into text.
+
+The log records hold format string addresses, so the ELF image of the same
+build is needed to read the strings back. Dump the buffer with the debugger,
+e.g. in gdb:
+    dump binary value log.bin RTOS_logBuffer
+or dump the whole RAM, the buffer is found by its magic word. Then run:
+    log_decode.py TimeOS.elf log.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+LOG_MAGIC = 0x4C4F4742
+HEADER_FORMAT = "<IIIIII"
+RECORD_FORMAT = "<IIII4I"
+MAX_ARGS = 4
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|t|j)?([diouxXcsp%])")
+
+
+class Image:
+    """Reads memory of the allocated sections of an ELF32 little endian image."""
+
+    def __init__(self, path):
+        with open(path, "rb") as elf:
+            self.data = elf.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            sys.exit("%s is not an ELF32 little endian image" % path)
+
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+        self.sections = []
+        for index in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", self.data,
+                                                                      shoff + index * shentsize)
+            if (flags & SHF_ALLOC) and sh_type != SHT_NOBITS and size > 0:
+                self.sections.append((addr, offset, size))
+
+    def string(self, address):
+        """Returns the C string at the address, or None outside the image."""
+        for addr, offset, size in self.sections:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.find(b"\0", start, offset + size)
+                if end < 0:
+                    end = offset + size
+                return self.data[start:end].decode("latin-1")
+        return None
+
+
+def find_buffer(data):
+    """Returns the offset of the log buffer in the dump."""
+    magic = struct.pack("<I", LOG_MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset % 4 == 0:
+            return offset
+        offset = data.find(magic, offset + 1)
+    sys.exit("log buffer magic not found")
+
+
+def read_records(data, offset):
+    """Returns the tick rate, the dropped and overwritten counts and the committed records in order."""
+    _, tick_rate_hz, records_num, write_count, read_count, dropped_count = \
+        struct.unpack_from(HEADER_FORMAT, data, offset)
+    offset += struct.calcsize(HEADER_FORMAT)
+    record_size = struct.calcsize(RECORD_FORMAT)
+
+    # With LOG_OVERWRITE the ring holds only the latest records_num records
+    first_count = max(read_count, write_count - records_num)
+    overwritten_count = first_count - read_count
+
+    records = []
+    for count in range(first_count, write_count):
+        index = count % records_num
+        record = struct.unpack_from(RECORD_FORMAT, data, offset + index * record_size)
+        # Records still being written when the dump was taken are skipped
+        if record[0] == count + 1:
+            records.append(record[1:])
+    return tick_rate_hz, dropped_count, overwritten_count, records
+
+
+def format_record(image, address, args):
+    """Formats the record the way printf would with 32-bit arguments."""
+    fmt = image.string(address)
+    if fmt is None:
+        return "<format 0x%08x not in image> %s" % (address, " ".join("0x%08x" % arg for arg in args))
+
+    remaining = list(args)
+
+    def convert(match):
+        flags, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        value = remaining.pop(0) if remaining else 0
+        if conversion in "di":
+            return ("%" + flags + "d") % (value - (1 << 32) if value & 0x80000000 else value)
+        if conversion == "u":
+            return ("%" + flags + "d") % value
+        if conversion == "c":
+            return ("%" + flags + "c") % chr(value & 0xFF)
+        if conversion == "s":
+            text = image.string(value)
+            return ("%" + flags + "s") % (text if text is not None else "<0x%08x>" % value)
+        if conversion == "p":
+            return "0x%08x" % value
+        return ("%" + flags + conversion) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="ELF image of the build that wrote the log")
+    parser.add_argument("dump", help="binary RAM dump containing RTOS_logBuffer")
+    args = parser.parse_args()
+
+    image = Image(args.elf)
+    with open(args.dump, "rb") as dump:
+        data = dump.read()
+
+    tick_rate_hz, dropped_count, overwritten_count, records = read_records(data, find_buffer(data))
+    for timestamp, header, address, *record_args in records:
+        args_num = min(header >> 24, MAX_ARGS)
+        text = format_record(image, address, record_args[:args_num])
+        sys.stdout.write("[%10.3f] thread %d: %s" % (timestamp / tick_rate_hz, header & 0xFFFFFF, text))
+        if not text.endswith("\n"):
+            sys.stdout.write("\n")
+    if dropped_count:
+        sys.stdout.write("%d records dropped\n" % dropped_count)
+    if overwritten_count:
+        sys.stdout.write("%d records overwritten\n" % overwritten_count)
+
+
+if __name__ == "__main__":
+    main()
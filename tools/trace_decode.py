@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+Decodes a TimeOS trace buffer RAM dump into Chrome/Perfetto trace JSON.
+
+Dump the buffer with the debugger, e.g. in gdb:
+    dump binary value trace.bin RTOS_traceBuffer
+or dump the whole RAM, the buffer is found by its magic word. Then run:
+    trace_decode.py trace.bin > trace.json
+and open trace.json in chrome://tracing or https://ui.perfetto.dev.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_MAGIC = 0x54524345
+HEADER_FORMAT = "<IIII"
+EVENT_FORMAT = "<III"
+
+EVENT_NAMES = [
+    "thread_switch",
+    "thread_ready",
+    "thread_block",
+    "timer_expire",
+    "svc",
+    "mutex_lock",
+    "mutex_release",
+    "semaphore_take",
+    "semaphore_give",
+    "mailbox_write",
+    "mailbox_read",
+]
+
+THREAD_SWITCH = 0
+
+
+def find_buffer(data):
+    """Returns the offset of the trace buffer in the dump."""
+    magic = struct.pack("<I", TRACE_MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset % 4 == 0:
+            return offset
+        offset = data.find(magic, offset + 1)
+    sys.exit("trace buffer magic not found")
+
+
+def read_events(data, offset):
+    """Returns the clock frequency and the events in recording order."""
+    _, clock_hz, events_num, write_count = struct.unpack_from(HEADER_FORMAT, data, offset)
+    offset += struct.calcsize(HEADER_FORMAT)
+    event_size = struct.calcsize(EVENT_FORMAT)
+
+    # Oldest event is overwritten first once the ring wraps
+    first = max(0, write_count - events_num)
+    events = []
+    for count in range(first, write_count):
+        index = count % events_num
+        events.append(struct.unpack_from(EVENT_FORMAT, data, offset + index * event_size))
+    return clock_hz, events
+
+
+def to_chrome(clock_hz, events):
+    """Converts the events into Chrome trace events, one track per thread."""
+    trace = []
+    time_us = 0.0
+    last_timestamp = None
+    running = None
+
+    for timestamp, header, obj in events:
+        # Cycle counter wraps every 2^32 cycles, accumulate the deltas. A delta is
+        # signed, an event may be stamped slightly before the previous slot
+        if last_timestamp is not None:
+            delta = (timestamp - last_timestamp) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            time_us += delta * 1e6 / clock_hz
+        last_timestamp = timestamp
+
+        event_type = header >> 24
+        thread_id = header & 0xFFFFFF
+        name = EVENT_NAMES[event_type] if event_type < len(EVENT_NAMES) else "event_%d" % event_type
+
+        if event_type == THREAD_SWITCH:
+            if running is not None:
+                trace.append({"name": "thread %d" % running, "ph": "E", "ts": time_us, "pid": 0, "tid": running})
+            running = obj
+            trace.append({"name": "thread %d" % running, "ph": "B", "ts": time_us, "pid": 0, "tid": running})
+        else:
+            trace.append({"name": name, "ph": "i", "s": "t", "ts": time_us, "pid": 0, "tid": thread_id,
+                          "args": {"object": "0x%08x" % obj}})
+
+    if running is not None:
+        trace.append({"name": "thread %d" % running, "ph": "E", "ts": time_us, "pid": 0, "tid": running})
+    return trace
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("dump", help="binary RAM dump containing RTOS_traceBuffer")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as dump:
+        data = dump.read()
+
+    clock_hz, events = read_events(data, find_buffer(data))
+    json.dump({"traceEvents": to_chrome(clock_hz, events), "displayTimeUnit": "ns"}, sys.stdout, indent=1)
+
+
+if __name__ == "__main__":
+    main()